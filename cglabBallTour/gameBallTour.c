@@ -131,7 +131,7 @@ static void update() {
   }
   multiplier = clamp(multiplier - 0.02 * difficulty, 1, 999);
   color = LIGHT1;
-  char multiplierText[5];
+  char multiplierText[7];
   sprintf(multiplierText, "x%d", (uint16_t)multiplier);
   text(multiplierText, 3, 9);
   if (isGameOver) {
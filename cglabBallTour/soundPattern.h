@@ -3,105 +3,56 @@
 #pragma once
 
 PROGMEM static const uint8_t coinSe[] = {
-  0x90, 0x4D, 0x00, 0x53, 0x90, 0x58, 0x00, 0xD9,
-  0x80, 0xF0,
+  0x05, 0x80, 0x4D, 0x0D, 0xCB, 0x00, 
 };
 
 PROGMEM static const uint8_t laserSe[] = {
-  0x90, 0x5D, 0x00, 0x10, 0x90, 0x5B, 0x00, 0x11,
-  0x90, 0x57, 0x00, 0x11, 0x90, 0x52, 0x00, 0x10,
-  0x90, 0x54, 0x00, 0x11, 0x90, 0x50, 0x00, 0x11,
-  0x90, 0x4D, 0x00, 0x10, 0x90, 0x4C, 0x00, 0x11,
-  0x90, 0x4D, 0x00, 0x11, 0x90, 0x4B, 0x00, 0x10,
-  0x90, 0x47, 0x00, 0x11, 0x90, 0x48, 0x00, 0x11,
-  0x90, 0x45, 0x00, 0x10, 0x90, 0x43, 0x00, 0x11,
-  0x90, 0x41, 0x00, 0x11, 0x90, 0x3F, 0x00, 0x10,
-  0x80, 0xF0,
+  0x01, 0x80, 0x5D, 0xBE, 0xBC, 0xBB, 0xC2, 0xBC,
+  0xBD, 0xBF, 0xC1, 0xBE, 0xBC, 0xC1, 0xBD, 0xBE,
+  0xBE, 0xBE, 0x00, 
 };
 
 PROGMEM static const uint8_t explosionSe[] = {
-  0x90, 0x49, 0x00, 0x10, 0x90, 0x42, 0x00, 0x11,
-  0x90, 0x4A, 0x00, 0x11, 0x90, 0x3E, 0x00, 0x10,
-  0x90, 0x37, 0x00, 0x11, 0x90, 0x35, 0x00, 0x11,
-  0x90, 0x2B, 0x00, 0x10, 0x90, 0x28, 0x00, 0x11,
-  0x90, 0x38, 0x00, 0x11, 0x90, 0x43, 0x00, 0x10,
-  0x90, 0x41, 0x00, 0x11, 0x90, 0x2A, 0x00, 0x11,
-  0x90, 0x41, 0x00, 0x10, 0x90, 0x31, 0x00, 0x11,
-  0x90, 0x2F, 0x00, 0x11, 0x90, 0x24, 0x00, 0x10,
-  0x90, 0x2E, 0x00, 0x11, 0x90, 0x2B, 0x00, 0x11,
-  0x90, 0x2F, 0x00, 0x10, 0x90, 0x30, 0x00, 0x11,
-  0x90, 0x2A, 0x00, 0x11, 0x90, 0x34, 0x00, 0x10,
-  0x90, 0x22, 0x00, 0x11, 0x90, 0x1F, 0x00, 0x11,
-  0x80, 0xF0,
+  0x01, 0x80, 0x49, 0xB9, 0xC8, 0xB4, 0xB9, 0xBE,
+  0xB6, 0xBD, 0xD0, 0xCB, 0xBE, 0xA9, 0xD7, 0xB0,
+  0xBE, 0xB5, 0xCA, 0xBD, 0xC4, 0xC1, 0xBA, 0xCA,
+  0xAE, 0xBD, 0x00, 
 };
 
 PROGMEM static const uint8_t powerUpSe[] = {
-  0x90, 0x53, 0x00, 0x10, 0x90, 0x4E, 0x00, 0x11,
-  0x90, 0x49, 0x00, 0x11, 0x90, 0x42, 0x00, 0x10,
-  0x90, 0x44, 0x00, 0x11, 0x90, 0x47, 0x00, 0x11,
-  0x90, 0x4A, 0x00, 0x10, 0x90, 0x4C, 0x00, 0x11,
-  0x90, 0x4F, 0x00, 0x11, 0x90, 0x52, 0x00, 0x10,
-  0x90, 0x54, 0x00, 0x11, 0x90, 0x5D, 0x00, 0x11,
-  0x90, 0x57, 0x00, 0x10, 0x90, 0x51, 0x00, 0x11,
-  0x90, 0x4B, 0x00, 0x11, 0x90, 0x4C, 0x00, 0x10,
-  0x90, 0x50, 0x00, 0x11, 0x90, 0x54, 0x00, 0x11,
-  0x90, 0x59, 0x00, 0x10, 0x90, 0x5D, 0x00, 0x11,
-  0x90, 0x62, 0x00, 0x11, 0x80, 0xF0,
+  0x01, 0x80, 0x53, 0xBB, 0xBB, 0xB9, 0xC2, 0xC3,
+  0xC3, 0xC2, 0xC3, 0xC3, 0xC2, 0xC9, 0xBA, 0xBA,
+  0xBA, 0xC1, 0xC4, 0xC4, 0xC5, 0xC4, 0xC5, 0x00,
 };
 
 PROGMEM static const uint8_t hitSe[] = {
-  0x90, 0x44, 0x00, 0x10, 0x90, 0x42, 0x00, 0x11,
-  0x90, 0x49, 0x00, 0x11, 0x90, 0x47, 0x00, 0x10,
-  0x90, 0x42, 0x00, 0x11, 0x80, 0xF0,
+  0x01, 0x80, 0x44, 0xBE, 0xC7, 0xBE, 0xBB, 0x00,
 };
 
 PROGMEM static const uint8_t jumpSe[] = {
-  0x90, 0x4F, 0x00, 0x42, 0x90, 0x3F, 0x00, 0x11,
-  0x90, 0x40, 0x00, 0x11, 0x90, 0x41, 0x00, 0x10,
-  0x90, 0x42, 0x00, 0x11, 0x90, 0x43, 0x00, 0x11,
-  0x90, 0x44, 0x00, 0x10, 0x90, 0x45, 0x00, 0x11,
-  0x90, 0x46, 0x00, 0x11, 0x90, 0x47, 0x00, 0x10,
-  0x90, 0x48, 0x00, 0x11, 0x90, 0x49, 0x00, 0x11,
-  0x90, 0x4A, 0x00, 0x10, 0x90, 0x4B, 0x00, 0x11,
-  0x90, 0x4C, 0x00, 0x11, 0x90, 0x4D, 0x00, 0x10,
-  0x90, 0x4E, 0x00, 0x11, 0x90, 0x4F, 0x00, 0x11,
-  0x90, 0x51, 0x00, 0x10, 0x80, 0xF0,
+  0x04, 0x80, 0x4F, 0x01, 0xB0, 0xC1, 0xC1, 0xC1,
+  0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC1,
+  0xC1, 0xC1, 0xC1, 0xC1, 0xC1, 0xC2, 0x00, 
 };
 
 PROGMEM static const uint8_t selectSe[] = {
-  0x90, 0x52, 0x00, 0x32, 0x90, 0x55, 0x00, 0x42,
-  0x80, 0xF0,
+  0x03, 0x80, 0x52, 0x04, 0xC3, 0x00, 
 };
 
 PROGMEM static const uint8_t randomSe[] = {
-  0x90, 0x3F, 0x00, 0x10, 0x90, 0x4B, 0x00, 0x11,
-  0x90, 0x4E, 0x00, 0x11, 0x90, 0x4A, 0x00, 0x10,
-  0x90, 0x34, 0x00, 0x11, 0x90, 0x3D, 0x00, 0x11,
-  0x90, 0x32, 0x00, 0x10, 0x90, 0x3D, 0x00, 0x11,
-  0x90, 0x3E, 0x00, 0x11, 0x90, 0x44, 0x00, 0x10,
-  0x90, 0x48, 0x00, 0x11, 0x90, 0x44, 0x00, 0x11,
-  0x90, 0x47, 0x00, 0x10, 0x90, 0x4D, 0x00, 0x11,
-  0x90, 0x4D, 0x00, 0x11, 0x90, 0x51, 0x00, 0x10,
-  0x90, 0x51, 0x00, 0x11, 0x90, 0x53, 0x00, 0x11,
-  0x90, 0x5C, 0x00, 0x10, 0x90, 0x53, 0x00, 0x11,
-  0x90, 0x61, 0x00, 0x11, 0x80, 0xF0,
+  0x01, 0x80, 0x3F, 0xCC, 0xC3, 0xBC, 0xAA, 0xC9,
+  0xB5, 0xCB, 0xC1, 0xC6, 0xC4, 0xBC, 0xC3, 0xC6,
+  0xC0, 0xC4, 0xC0, 0xC2, 0xC9, 0xB7, 0xCE, 0x00,
 };
 
 PROGMEM static const uint8_t clickSe[] = {
-  0x90, 0x44, 0x00, 0x21, 0x80, 0x00, 0x21, 0x90,
-  0x53, 0x00, 0x22, 0x80, 0xF0,
+  0x02, 0x80, 0x44, 0x42, 0xCF, 0x00, 
 };
 
 PROGMEM static const uint8_t bgm[] = {
-  0x90, 0x49, 0x00, 0x85, 0x80, 0x00, 0x85, 0x90,
-  0x45, 0x00, 0x86, 0x80, 0x00, 0x85, 0x90, 0x42,
-  0x00, 0x85, 0x80, 0x01, 0x90, 0x90, 0x47, 0x00,
-  0x86, 0x80, 0x00, 0x85, 0x90, 0x40, 0x00, 0x85,
-  0x80, 0x02, 0x9B, 0x90, 0x44, 0x00, 0x85, 0x80,
-  0x00, 0x86, 0x90, 0x40, 0x00, 0x85, 0x80, 0x00,
-  0x85, 0x90, 0x3D, 0x00, 0x86, 0x80, 0x01, 0x90,
-  0x90, 0x3E, 0x00, 0x85, 0x80, 0x00, 0x85, 0x90,
-  0x45, 0x00, 0x86, 0x80, 0xE0,
+  0x08, 0x80, 0x49, 0x48, 0xBC, 0x48, 0xBD, 0x58,
+  0xC5, 0x48, 0xB9, 0x68, 0xC4, 0x48, 0xBC, 0x48,
+  0xBD, 0x58, 0xC1, 0x48, 0xC7, 0x68, 0x40, 
 };
 
 PROGMEM static const uint8_t * const soundPatterns[] = {
@@ -0,0 +1,5 @@
+#pragma once
+
+// A frame stores 31 hit boxes at most: the multiplier (4 characters), the 4
+// lines, the player, 21 dots and the enemy.
+#define MAX_HIT_BOX_COUNT 32
@@ -83,7 +83,7 @@ static void update() {
   }
   animTicks += (uint8_t)(difficulty * 8);
   color = LIGHT1;
-  char multiplierText[5];
+  char multiplierText[7];
   sprintf(multiplierText, "x%d", (uint16_t)multiplier);
   text(multiplierText, 3, 9);
   if (player.vx > 0 && btn(INPUT_LEFT)) {
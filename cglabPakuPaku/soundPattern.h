@@ -3,98 +3,55 @@
 #pragma once
 
 PROGMEM static const uint8_t coinSe[] = {
-  0x90, 0x4E, 0x00, 0x74, 0x90, 0x57, 0x00, 0x86,
-  0x80, 0xF0, 
+  0x07, 0x80, 0x4E, 0x08, 0xC9, 0x00, 
 };
 
 PROGMEM static const uint8_t laserSe[] = {
-  0x90, 0x48, 0x00, 0x10, 0x90, 0x4E, 0x00, 0x11,
-  0x90, 0x4D, 0x00, 0x11, 0x90, 0x43, 0x00, 0x10,
-  0x90, 0x47, 0x00, 0x11, 0x90, 0x46, 0x00, 0x11,
-  0x90, 0x3F, 0x00, 0x10, 0x90, 0x40, 0x00, 0x11,
-  0x90, 0x3D, 0x00, 0x11, 0x90, 0x3B, 0x00, 0x10,
-  0x90, 0x3A, 0x00, 0x11, 0x80, 0xF0, 
+  0x01, 0x80, 0x48, 0xC6, 0xBF, 0xB6, 0xC4, 0xBF,
+  0xB9, 0xC1, 0xBD, 0xBE, 0xBF, 0x00, 
 };
 
 PROGMEM static const uint8_t explosionSe[] = {
-  0x90, 0x55, 0x00, 0x10, 0x90, 0x46, 0x00, 0x11,
-  0x90, 0x41, 0x00, 0x11, 0x90, 0x3B, 0x00, 0x10,
-  0x90, 0x2B, 0x00, 0x11, 0x90, 0x3D, 0x00, 0x11,
-  0x90, 0x3D, 0x00, 0x10, 0x90, 0x3A, 0x00, 0x11,
-  0x90, 0x2C, 0x00, 0x11, 0x90, 0x3F, 0x00, 0x10,
-  0x90, 0x44, 0x00, 0x11, 0x90, 0x3D, 0x00, 0x11,
-  0x90, 0x39, 0x00, 0x10, 0x90, 0x30, 0x00, 0x11,
-  0x90, 0x30, 0x00, 0x11, 0x90, 0x33, 0x00, 0x10,
-  0x90, 0x29, 0x00, 0x11, 0x90, 0x27, 0x00, 0x11,
-  0x90, 0x2C, 0x00, 0x10, 0x90, 0x2D, 0x00, 0x11,
-  0x90, 0x34, 0x00, 0x11, 0x90, 0x2B, 0x00, 0x10,
-  0x90, 0x27, 0x00, 0x11, 0x90, 0x2A, 0x00, 0x11,
-  0x80, 0xF0, 
+  0x01, 0x80, 0x55, 0xB1, 0xBB, 0xBA, 0xB0, 0xD2,
+  0xC0, 0xBD, 0xB2, 0xD3, 0xC5, 0xB9, 0xBC, 0xB7,
+  0xC0, 0xC3, 0xB6, 0xBE, 0xC5, 0xC1, 0xC7, 0xB7,
+  0xBC, 0xC3, 0x00, 
 };
 
 PROGMEM static const uint8_t powerUpSe[] = {
-  0x90, 0x4F, 0x00, 0x10, 0x90, 0x4B, 0x00, 0x11,
-  0x90, 0x47, 0x00, 0x11, 0x90, 0x43, 0x00, 0x10,
-  0x90, 0x49, 0x00, 0x11, 0x90, 0x4C, 0x00, 0x11,
-  0x90, 0x4F, 0x00, 0x10, 0x90, 0x52, 0x00, 0x11,
-  0x90, 0x55, 0x00, 0x11, 0x90, 0x58, 0x00, 0x10,
-  0x90, 0x5B, 0x00, 0x11, 0x90, 0x5E, 0x00, 0x11,
-  0x90, 0x58, 0x00, 0x10, 0x90, 0x52, 0x00, 0x11,
-  0x90, 0x51, 0x00, 0x11, 0x90, 0x54, 0x00, 0x10,
-  0x90, 0x57, 0x00, 0x11, 0x90, 0x5A, 0x00, 0x11,
-  0x90, 0x5D, 0x00, 0x10, 0x90, 0x60, 0x00, 0x11,
-  0x80, 0xF0, 
+  0x01, 0x80, 0x4F, 0xBC, 0xBC, 0xBC, 0xC6, 0xC3,
+  0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xBA, 0xBA,
+  0xBF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x00, 
 };
 
 PROGMEM static const uint8_t hitSe[] = {
-  0x90, 0x48, 0x00, 0x10, 0x90, 0x47, 0x00, 0x11,
-  0x90, 0x45, 0x00, 0x11, 0x90, 0x44, 0x00, 0x10,
-  0x90, 0x44, 0x00, 0x11, 0x90, 0x42, 0x00, 0x11,
-  0x90, 0x43, 0x00, 0x10, 0x90, 0x42, 0x00, 0x11,
-  0x80, 0xF0, 
+  0x01, 0x80, 0x48, 0xBF, 0xBE, 0xBF, 0xC0, 0xBE,
+  0xC1, 0xBF, 0x00, 
 };
 
 PROGMEM static const uint8_t jumpSe[] = {
-  0x90, 0x46, 0x00, 0x42, 0x90, 0x37, 0x00, 0x11,
-  0x90, 0x3A, 0x00, 0x11, 0x90, 0x3D, 0x00, 0x10,
-  0x90, 0x40, 0x00, 0x11, 0x90, 0x43, 0x00, 0x11,
-  0x90, 0x46, 0x00, 0x10, 0x90, 0x49, 0x00, 0x11,
-  0x90, 0x4C, 0x00, 0x11, 0x90, 0x4F, 0x00, 0x10,
-  0x90, 0x52, 0x00, 0x11, 0x90, 0x55, 0x00, 0x11,
-  0x80, 0xF0, 
+  0x04, 0x80, 0x46, 0x01, 0xB1, 0xC3, 0xC3, 0xC3,
+  0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x00,
 };
 
 PROGMEM static const uint8_t selectSe[] = {
-  0x90, 0x3E, 0x00, 0x32, 0x90, 0x40, 0x00, 0x53,
-  0x80, 0xF0, 
+  0x03, 0x80, 0x3E, 0x05, 0xC2, 0x00, 
 };
 
 PROGMEM static const uint8_t randomSe[] = {
-  0x90, 0x2C, 0x00, 0x10, 0x90, 0x24, 0x00, 0x11,
-  0x90, 0x24, 0x00, 0x11, 0x90, 0x2E, 0x00, 0x10,
-  0x90, 0x28, 0x00, 0x11, 0x90, 0x29, 0x00, 0x11,
-  0x90, 0x30, 0x00, 0x10, 0x90, 0x24, 0x00, 0x11,
-  0x90, 0x1E, 0x00, 0x11, 0x90, 0x25, 0x00, 0x10,
-  0x90, 0x32, 0x00, 0x11, 0x90, 0x2C, 0x00, 0x11,
-  0x90, 0x3C, 0x00, 0x10, 0x90, 0x3B, 0x00, 0x11,
-  0x90, 0x3E, 0x00, 0x11, 0x80, 0xF0, 
+  0x01, 0x80, 0x2C, 0xB8, 0xC0, 0xCA, 0xBA, 0xC1,
+  0xC7, 0xB4, 0xBA, 0xC7, 0xCD, 0xBA, 0xD0, 0xBF,
+  0xC3, 0x00, 
 };
 
 PROGMEM static const uint8_t clickSe[] = {
-  0x90, 0x4A, 0x00, 0x21, 0x80, 0x00, 0x21, 0x90,
-  0x4E, 0x00, 0x22, 0x80, 0xF0, 
+  0x02, 0x80, 0x4A, 0x42, 0xC4, 0x00, 
 };
 
 PROGMEM static const uint8_t bgm[] = {
-  0x90, 0x42, 0x00, 0x85, 0x80, 0x02, 0x9B, 0x90,
-  0x42, 0x00, 0x85, 0x80, 0x00, 0x85, 0x90, 0x3E,
-  0x00, 0x86, 0x80, 0x01, 0x90, 0x90, 0x3E, 0x00,
-  0x85, 0x80, 0x00, 0x85, 0x90, 0x3E, 0x00, 0x86,
-  0x80, 0x00, 0x85, 0x90, 0x37, 0x00, 0x85, 0x80,
-  0x02, 0x9B, 0x90, 0x4C, 0x00, 0x85, 0x80, 0x00,
-  0x86, 0x90, 0x49, 0x00, 0x85, 0x80, 0x01, 0x90,
-  0x90, 0x42, 0x00, 0x85, 0x80, 0x00, 0x86, 0x90,
-  0x49, 0x00, 0x85, 0x80, 0xE0, 
+  0x08, 0x80, 0x42, 0x68, 0xC0, 0x48, 0xBC, 0x58,
+  0xC0, 0x48, 0xC0, 0x48, 0xB9, 0x68, 0xD5, 0x48,
+  0xBD, 0x58, 0xB9, 0x48, 0xC7, 0x48, 0x40, 
 };
 
 PROGMEM static const uint8_t * const soundPatterns[] = {
@@ -3,102 +3,57 @@
 #pragma once
 
 PROGMEM static const uint8_t coinSe[] = {
-  0x90, 0x46, 0x00, 0x64, 0x90, 0x5E, 0x00, 0xB7,
-  0x80, 0xF0,
+  0x06, 0x80, 0x46, 0x0B, 0xD8, 0x00, 
 };
 
 PROGMEM static const uint8_t laserSe[] = {
-  0x90, 0x5F, 0x00, 0x10, 0x90, 0x5C, 0x00, 0x11,
-  0x90, 0x54, 0x00, 0x11, 0x90, 0x52, 0x00, 0x10,
-  0x90, 0x4A, 0x00, 0x11, 0x90, 0x45, 0x00, 0x11,
-  0x90, 0x41, 0x00, 0x10, 0x90, 0x3E, 0x00, 0x11,
-  0x90, 0x39, 0x00, 0x11, 0x80, 0xF0,
+  0x01, 0x80, 0x5F, 0xBD, 0xB8, 0xBE, 0xB8, 0xBB,
+  0xBC, 0xBD, 0xBB, 0x00, 
 };
 
 PROGMEM static const uint8_t explosionSe[] = {
-  0x90, 0x59, 0x00, 0x10, 0x90, 0x47, 0x00, 0x11,
-  0x90, 0x52, 0x00, 0x11, 0x90, 0x45, 0x00, 0x10,
-  0x90, 0x4F, 0x00, 0x11, 0x90, 0x4E, 0x00, 0x11,
-  0x90, 0x45, 0x00, 0x10, 0x90, 0x3D, 0x00, 0x11,
-  0x90, 0x34, 0x00, 0x11, 0x90, 0x2B, 0x00, 0x10,
-  0x90, 0x51, 0x00, 0x11, 0x90, 0x4C, 0x00, 0x11,
-  0x90, 0x2E, 0x00, 0x10, 0x90, 0x4B, 0x00, 0x11,
-  0x90, 0x38, 0x00, 0x11, 0x90, 0x36, 0x00, 0x10,
-  0x90, 0x29, 0x00, 0x11, 0x90, 0x46, 0x00, 0x11,
-  0x90, 0x2D, 0x00, 0x10, 0x90, 0x36, 0x00, 0x11,
-  0x90, 0x3C, 0x00, 0x11, 0x90, 0x2A, 0x00, 0x10,
-  0x90, 0x38, 0x00, 0x11, 0x90, 0x37, 0x00, 0x11,
-  0x90, 0x26, 0x00, 0x10, 0x90, 0x24, 0x00, 0x11,
-  0x90, 0x2B, 0x00, 0x11, 0x90, 0x30, 0x00, 0x10,
-  0x80, 0xF0,
+  0x01, 0x80, 0x59, 0xAE, 0xCB, 0xB3, 0xCA, 0xBF,
+  0xB7, 0xB8, 0xB7, 0xB7, 0xE6, 0xBB, 0xA2, 0xDD,
+  0xAD, 0xBE, 0xB3, 0xDD, 0xA7, 0xC9, 0xC6, 0xAE,
+  0xCE, 0xBF, 0xAF, 0xBE, 0xC7, 0xC5, 0x00, 
 };
 
 PROGMEM static const uint8_t powerUpSe[] = {
-  0x90, 0x4B, 0x00, 0x10, 0x90, 0x48, 0x00, 0x11,
-  0x90, 0x45, 0x00, 0x11, 0x90, 0x42, 0x00, 0x10,
-  0x90, 0x42, 0x00, 0x11, 0x90, 0x45, 0x00, 0x11,
-  0x90, 0x49, 0x00, 0x10, 0x90, 0x4C, 0x00, 0x11,
-  0x90, 0x50, 0x00, 0x11, 0x90, 0x53, 0x00, 0x10,
-  0x90, 0x57, 0x00, 0x11, 0x90, 0x5A, 0x00, 0x11,
-  0x90, 0x56, 0x00, 0x10, 0x90, 0x55, 0x00, 0x11,
-  0x90, 0x54, 0x00, 0x11, 0x90, 0x53, 0x00, 0x10,
-  0x90, 0x4C, 0x00, 0x11, 0x90, 0x4F, 0x00, 0x11,
-  0x90, 0x53, 0x00, 0x10, 0x90, 0x57, 0x00, 0x11,
-  0x90, 0x5B, 0x00, 0x11, 0x90, 0x5F, 0x00, 0x10,
-  0x90, 0x63, 0x00, 0x11, 0x90, 0x67, 0x00, 0x11,
-  0x80, 0xF0,
+  0x01, 0x80, 0x4B, 0xBD, 0xBD, 0xBD, 0xC0, 0xC3,
+  0xC4, 0xC3, 0xC4, 0xC3, 0xC4, 0xC3, 0xBC, 0xBF,
+  0xBF, 0xBF, 0xB9, 0xC3, 0xC4, 0xC4, 0xC4, 0xC4,
+  0xC4, 0xC4, 0x00, 
 };
 
 PROGMEM static const uint8_t hitSe[] = {
-  0x90, 0x46, 0x00, 0x10, 0x90, 0x47, 0x00, 0x11,
-  0x90, 0x45, 0x00, 0x11, 0x90, 0x47, 0x00, 0x10,
-  0x90, 0x46, 0x00, 0x11, 0x90, 0x45, 0x00, 0x11,
-  0x90, 0x41, 0x00, 0x10, 0x90, 0x44, 0x00, 0x11,
-  0x80, 0xF0,
+  0x01, 0x80, 0x46, 0xC1, 0xBE, 0xC2, 0xBF, 0xBF,
+  0xBC, 0xC3, 0x00, 
 };
 
 PROGMEM static const uint8_t jumpSe[] = {
-  0x90, 0x48, 0x00, 0x42, 0x90, 0x37, 0x00, 0x11,
-  0x90, 0x39, 0x00, 0x11, 0x90, 0x3C, 0x00, 0x10,
-  0x90, 0x3F, 0x00, 0x11, 0x90, 0x42, 0x00, 0x11,
-  0x90, 0x45, 0x00, 0x10, 0x90, 0x48, 0x00, 0x11,
-  0x90, 0x4B, 0x00, 0x11, 0x90, 0x4E, 0x00, 0x10,
-  0x90, 0x51, 0x00, 0x11, 0x90, 0x54, 0x00, 0x11,
-  0x90, 0x57, 0x00, 0x10, 0x90, 0x5A, 0x00, 0x11,
-  0x90, 0x5C, 0x00, 0x11, 0x80, 0xF0,
+  0x04, 0x80, 0x48, 0x01, 0xAF, 0xC2, 0xC3, 0xC3,
+  0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3,
+  0xC3, 0xC2, 0x00, 
 };
 
 PROGMEM static const uint8_t selectSe[] = {
-  0x90, 0x4F, 0x00, 0x21, 0x90, 0x50, 0x00, 0x85,
-  0x80, 0xF0,
+  0x02, 0x80, 0x4F, 0x08, 0xC1, 0x00, 
 };
 
 PROGMEM static const uint8_t randomSe[] = {
-  0x90, 0x43, 0x00, 0x10, 0x90, 0x46, 0x00, 0x11,
-  0x90, 0x44, 0x00, 0x11, 0x90, 0x3A, 0x00, 0x10,
-  0x90, 0x19, 0x00, 0x11, 0x90, 0x51, 0x00, 0x11,
-  0x90, 0x62, 0x00, 0x10, 0x90, 0x59, 0x00, 0x11,
-  0x90, 0x48, 0x00, 0x11, 0x90, 0x51, 0x00, 0x10,
-  0x90, 0x47, 0x00, 0x11, 0x90, 0x43, 0x00, 0x11,
-  0x90, 0x46, 0x00, 0x10, 0x90, 0x3A, 0x00, 0x11,
-  0x80, 0xF0,
+  0x01, 0x80, 0x43, 0xC3, 0xBE, 0xB6, 0x9F, 0xF8,
+  0xD1, 0xB7, 0xAF, 0xC9, 0xB6, 0xBC, 0xC3, 0xB4,
+  0x00, 
 };
 
 PROGMEM static const uint8_t clickSe[] = {
-  0x90, 0x47, 0x00, 0x10, 0x80, 0x00, 0x11, 0x90,
-  0x4A, 0x00, 0x21, 0x80, 0xF0,
+  0x01, 0x80, 0x47, 0x41, 0x02, 0xC3, 0x00, 
 };
 
 PROGMEM static const uint8_t bgm[] = {
-  0x90, 0x3E, 0x00, 0x85, 0x80, 0x00, 0x85, 0x90,
-  0x45, 0x00, 0x86, 0x80, 0x01, 0x90, 0x90, 0x4A,
-  0x00, 0x85, 0x80, 0x00, 0x85, 0x90, 0x41, 0x00,
-  0x86, 0x80, 0x02, 0x9A, 0x90, 0x48, 0x00, 0x86,
-  0x80, 0x00, 0x85, 0x90, 0x3E, 0x00, 0x85, 0x80,
-  0x00, 0x86, 0x90, 0x3E, 0x00, 0x85, 0x80, 0x01,
-  0x90, 0x90, 0x3E, 0x00, 0x85, 0x80, 0x00, 0x86,
-  0x90, 0x3C, 0x00, 0x85, 0x80, 0x02, 0x9B, 0x90,
-  0x40, 0x00, 0x85, 0x80, 0xE0,
+  0x08, 0x80, 0x3E, 0x48, 0xC7, 0x58, 0xC5, 0x48,
+  0xB7, 0x68, 0xC7, 0x48, 0xB6, 0x48, 0xC0, 0x58,
+  0xC0, 0x48, 0xBE, 0x68, 0xC4, 0x48, 0x40, 
 };
 
 PROGMEM static const uint8_t * const soundPatterns[] = {
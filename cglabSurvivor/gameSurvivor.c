@@ -113,7 +113,7 @@ static void update() {
         ASSIGN_ARRAY_ITEM(players, j, Player, ap);
         SKIP_IS_NOT_ALIVE(ap);
         if (i != j && p->isOnFloor &&
-            distanceTo(&p->pos, VEC_XY(ap->pos)) < 4) {
+            withinDistance(&p->pos, VEC_XY(ap->pos), 4)) {
           play(SELECT);
           Player *bp = p;
           for (int k = 0; k < 99; k++) {
@@ -3,95 +3,54 @@
 #pragma once
 
 PROGMEM static const uint8_t coinSe[] = {
-  0x90, 0x48, 0x00, 0x53, 0x90, 0x56, 0x00, 0x96,
-  0x80, 0xF0,
+  0x05, 0x80, 0x48, 0x09, 0xCE, 0x00, 
 };
 
 PROGMEM static const uint8_t laserSe[] = {
-  0x90, 0x54, 0x00, 0x10, 0x90, 0x59, 0x00, 0x11,
-  0x90, 0x53, 0x00, 0x11, 0x90, 0x52, 0x00, 0x10,
-  0x90, 0x50, 0x00, 0x11, 0x90, 0x48, 0x00, 0x11,
-  0x90, 0x4D, 0x00, 0x10, 0x90, 0x47, 0x00, 0x11,
-  0x90, 0x42, 0x00, 0x11, 0x90, 0x43, 0x00, 0x10,
-  0x90, 0x3F, 0x00, 0x11, 0x90, 0x3F, 0x00, 0x11,
-  0x90, 0x3B, 0x00, 0x10, 0x90, 0x39, 0x00, 0x11,
-  0x90, 0x36, 0x00, 0x11, 0x80, 0xF0, 
+  0x01, 0x80, 0x54, 0xC5, 0xBA, 0xBF, 0xBE, 0xB8,
+  0xC5, 0xBA, 0xBB, 0xC1, 0xBC, 0xC0, 0xBC, 0xBE,
+  0xBD, 0x00, 
 };
 
 PROGMEM static const uint8_t explosionSe[] = {
-  0x90, 0x58, 0x00, 0x10, 0x90, 0x4B, 0x00, 0x11,
-  0x90, 0x47, 0x00, 0x11, 0x90, 0x52, 0x00, 0x10,
-  0x90, 0x3C, 0x00, 0x11, 0x90, 0x4B, 0x00, 0x11,
-  0x90, 0x2C, 0x00, 0x10, 0x90, 0x4C, 0x00, 0x11,
-  0x90, 0x2B, 0x00, 0x11, 0x90, 0x45, 0x00, 0x10,
-  0x90, 0x48, 0x00, 0x11, 0x90, 0x37, 0x00, 0x11,
-  0x90, 0x38, 0x00, 0x10, 0x90, 0x40, 0x00, 0x11,
-  0x90, 0x2E, 0x00, 0x11, 0x90, 0x2F, 0x00, 0x10,
-  0x90, 0x27, 0x00, 0x11, 0x90, 0x2C, 0x00, 0x11,
-  0x90, 0x39, 0x00, 0x10, 0x90, 0x29, 0x00, 0x11,
-  0x90, 0x26, 0x00, 0x11, 0x80, 0xF0,
+  0x01, 0x80, 0x58, 0xB3, 0xBC, 0xCB, 0xAA, 0xCF,
+  0xA1, 0xE0, 0x9F, 0xDA, 0xC3, 0xAF, 0xC1, 0xC8,
+  0xAE, 0xC1, 0xB8, 0xC5, 0xCD, 0xB0, 0xBD, 0x00,
 };
 
 PROGMEM static const uint8_t powerUpSe[] = {
-  0x90, 0x53, 0x00, 0x10, 0x90, 0x4E, 0x00, 0x11,
-  0x90, 0x49, 0x00, 0x11, 0x90, 0x4A, 0x00, 0x10,
-  0x90, 0x4E, 0x00, 0x11, 0x90, 0x52, 0x00, 0x11,
-  0x90, 0x56, 0x00, 0x10, 0x90, 0x5A, 0x00, 0x11,
-  0x90, 0x5E, 0x00, 0x11, 0x90, 0x5A, 0x00, 0x10,
-  0x90, 0x53, 0x00, 0x11, 0x90, 0x4C, 0x00, 0x11,
-  0x90, 0x4B, 0x00, 0x10, 0x90, 0x4E, 0x00, 0x11,
-  0x90, 0x52, 0x00, 0x11, 0x90, 0x56, 0x00, 0x10,
-  0x90, 0x5A, 0x00, 0x11, 0x90, 0x5E, 0x00, 0x11,
-  0x90, 0x61, 0x00, 0x10, 0x80, 0xF0,
+  0x01, 0x80, 0x53, 0xBB, 0xBB, 0xC1, 0xC4, 0xC4,
+  0xC4, 0xC4, 0xC4, 0xBC, 0xB9, 0xB9, 0xBF, 0xC3,
+  0xC4, 0xC4, 0xC4, 0xC4, 0xC3, 0x00, 
 };
 
 PROGMEM static const uint8_t hitSe[] = {
-  0x90, 0x4B, 0x00, 0x10, 0x90, 0x4A, 0x00, 0x11,
-  0x90, 0x49, 0x00, 0x11, 0x90, 0x49, 0x00, 0x10,
-  0x90, 0x43, 0x00, 0x11, 0x80, 0xF0,
+  0x01, 0x80, 0x4B, 0xBF, 0xBF, 0xC0, 0xBA, 0x00,
 };
 
 PROGMEM static const uint8_t jumpSe[] = {
-  0x90, 0x4E, 0x00, 0x42, 0x90, 0x3D, 0x00, 0x11,
-  0x90, 0x3F, 0x00, 0x11, 0x90, 0x41, 0x00, 0x10,
-  0x90, 0x43, 0x00, 0x11, 0x90, 0x45, 0x00, 0x11,
-  0x90, 0x47, 0x00, 0x10, 0x90, 0x49, 0x00, 0x11,
-  0x90, 0x4B, 0x00, 0x11, 0x90, 0x4D, 0x00, 0x10,
-  0x90, 0x4F, 0x00, 0x11, 0x90, 0x51, 0x00, 0x11,
-  0x90, 0x53, 0x00, 0x10, 0x90, 0x55, 0x00, 0x11,
-  0x90, 0x57, 0x00, 0x11, 0x90, 0x59, 0x00, 0x10,
-  0x90, 0x5B, 0x00, 0x11, 0x90, 0x5E, 0x00, 0x11,
-  0x80, 0xF0,
+  0x04, 0x80, 0x4E, 0x01, 0xAF, 0xC2, 0xC2, 0xC2,
+  0xC2, 0xC2, 0xC2, 0xC2, 0xC2, 0xC2, 0xC2, 0xC2,
+  0xC2, 0xC2, 0xC2, 0xC2, 0xC3, 0x00, 
 };
 
 PROGMEM static const uint8_t selectSe[] = {
-  0x90, 0x44, 0x00, 0x21, 0x90, 0x44, 0x00, 0x43,
-  0x80, 0xF0, 
+  0x02, 0x80, 0x44, 0x04, 0xC0, 0x00, 
 };
 
 PROGMEM static const uint8_t randomSe[] = {
-  0x90, 0x38, 0x00, 0x10, 0x90, 0x3D, 0x00, 0x11,
-  0x90, 0x4F, 0x00, 0x11, 0x90, 0x4D, 0x00, 0x10,
-  0x90, 0x5A, 0x00, 0x11, 0x90, 0x65, 0x00, 0x11,
-  0x90, 0x50, 0x00, 0x10, 0x90, 0x52, 0x00, 0x11,
-  0x90, 0x4A, 0x00, 0x11, 0x90, 0x51, 0x00, 0x10,
-  0x90, 0x46, 0x00, 0x11, 0x90, 0x45, 0x00, 0x11,
-  0x90, 0x4D, 0x00, 0x10, 0x90, 0x44, 0x00, 0x11,
-  0x90, 0x3F, 0x00, 0x11, 0x80, 0xF0,
+  0x01, 0x80, 0x38, 0xC5, 0xD2, 0xBE, 0xCD, 0xCB,
+  0xAB, 0xC2, 0xB8, 0xC7, 0xB5, 0xBF, 0xC8, 0xB7,
+  0xBB, 0x00, 
 };
 
 PROGMEM static const uint8_t clickSe[] = {
-  0x90, 0x4A, 0x00, 0x21, 0x80, 0x00, 0x21, 0x90,
-  0x54, 0x00, 0x11, 0x80, 0xF0,
+  0x02, 0x80, 0x4A, 0x42, 0x01, 0xCA, 0x00, 
 };
 
 PROGMEM static const uint8_t bgm[] = {
-  0x90, 0x39, 0x00, 0x85, 0x80, 0x00, 0x85, 0x90,
-  0x3D, 0x00, 0x86, 0x80, 0x03, 0xA5, 0x90, 0x3D,
-  0x00, 0x85, 0x80, 0x02, 0x9B, 0x90, 0x39, 0x00,
-  0x85, 0x80, 0x00, 0x86, 0x90, 0x3D, 0x00, 0x85,
-  0x80, 0x03, 0xA5, 0x90, 0x3E, 0x00, 0x86, 0x80,
-  0xE0,
+  0x08, 0x80, 0x39, 0x48, 0xC4, 0x78, 0xC0, 0x68,
+  0xBC, 0x48, 0xC4, 0x78, 0xC1, 0x68, 0x40, 
 };
 
 PROGMEM static const uint8_t * const soundPatterns[] = {
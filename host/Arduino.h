@@ -0,0 +1,30 @@
+// The subset of the Arduino/AVR API that the library and the games use, to
+// build them for the host. PROGMEM data is in ordinary memory on the host.
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define F_CPU 16000000L
+
+#define PROGMEM
+
+#define pgm_read_byte(p)  (*(const uint8_t *)(p))
+#define pgm_read_word(p)  (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define pgm_read_ptr(p)   (*(void *const *)(p))
+#define strlen_P          strlen
+
+#define bit(b)           (1UL << (b))
+#define bitRead(v, b)    (((v) >> (b)) & 1)
+#define bitSet(v, b)     ((v) |= bit(b))
+#define bitClear(v, b)   ((v) &= ~bit(b))
+#define bitToggle(v, b)  ((v) ^= bit(b))
+
+#endif
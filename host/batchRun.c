@@ -0,0 +1,242 @@
+// Play many seeded sessions of the games headless in worker processes, one per
+// core by default, and report the histograms of the score and the length of
+// the sessions with the sessions per second.
+//   batchRun [-s sessions] [-S first seed] [-j workers] [-l seconds]
+//            [-p random | scripted] [game...]
+// A session starts the game with a seed, leaves the title, and plays with the
+// input policy until the game is over or for `-l` seconds of the game.
+#include <Arduino.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "cglab.h"
+#include "hostMachine.h"
+#include "hostGames.h"
+#include "random.h"
+#include "scriptedInput.h"
+
+// Sessions taken from the queue at once by a worker.
+#define SESSION_CHUNK_SIZE 16
+#define HISTOGRAM_BIN_COUNT 10
+#define HISTOGRAM_BAR_WIDTH 40
+
+typedef struct {
+  uint32_t score;
+  uint32_t frameCount;
+  bool isOver;
+} Session;
+
+// Shared by the workers, with the results of every session.
+typedef struct {
+  atomic_uint nextSession;
+  Session sessions[];
+} Batch;
+
+static const HostGame *games[HOST_GAME_COUNT];
+static uint8_t gameCount;
+static uint32_t sessionCount = 1000;
+static uint32_t firstSeed = 1;
+static uint32_t maxFrameCount = 600 * FPS;
+static bool isRandomPolicy = true;
+
+static double getTime(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Random buttons held for 4 to 19 frames, from the seed of the session.
+static uint8_t getRandomInput(Random *random, uint8_t *holdCount,
+                              uint8_t *input) {
+  if (*holdCount == 0) {
+    static const uint8_t directions[] = {
+      0, INPUT_LEFT, INPUT_RIGHT, INPUT_UP, INPUT_DOWN, 0, 0, 0,
+    };
+    uint32_t r = randomNext(random);
+    *input = ((r & bit(0)) ? INPUT_A : 0) |
+             ((r & (bit(1) | bit(2) | bit(3))) == 0 ? INPUT_B : 0) |
+             directions[(r >> 4) & 7];
+    *holdCount = 4 + ((r >> 8) & 15);
+  }
+  (*holdCount)--;
+  return *input;
+}
+
+static void runSession(const HostGame *game, uint32_t seed, Session *session) {
+  startHostGame(game, seed);
+  // Press A every other frame to leave the title.
+  for (uint8_t i = 0; getGameState() == STATE_TITLE; i++) {
+    hostInput = (i & 1) ? INPUT_A : 0;
+    updateGame();
+  }
+  Random random;
+  randomSetSeed(&random, seed);
+  uint8_t holdCount = 0, input = 0;
+  uint32_t frame;
+  for (frame = 0; frame < maxFrameCount; frame++) {
+    hostInput = isRandomPolicy ? getRandomInput(&random, &holdCount, &input)
+                               : getScriptedInput(frame);
+    updateGame();
+    if (getGameState() != STATE_IN_GAME) {
+      break;
+    }
+  }
+  session->score = NUM_INT(score);
+  session->frameCount = frame;
+  session->isOver = frame < maxFrameCount;
+}
+
+static void runWorker(Batch *batch) {
+  disableRendering();
+  uint32_t totalCount = sessionCount * gameCount;
+  uint32_t index;
+  while ((index = atomic_fetch_add(&batch->nextSession, SESSION_CHUNK_SIZE)) <
+         totalCount) {
+    uint32_t endIndex = index + SESSION_CHUNK_SIZE;
+    if (endIndex > totalCount) {
+      endIndex = totalCount;
+    }
+    for (; index < endIndex; index++) {
+      runSession(games[index / sessionCount],
+                 firstSeed + index % sessionCount, &batch->sessions[index]);
+    }
+  }
+}
+
+static int compareValues(const void *a, const void *b) {
+  uint32_t va = *(const uint32_t *)a, vb = *(const uint32_t *)b;
+  return (va > vb) - (va < vb);
+}
+
+// Sort `values` and print their percentiles and histogram.
+static void printDistribution(const char *name, uint32_t *values,
+                              double scale) {
+  qsort(values, sessionCount, sizeof(uint32_t), compareValues);
+  double total = 0;
+  for (uint32_t i = 0; i < sessionCount; i++) {
+    total += values[i];
+  }
+  uint32_t max = values[sessionCount - 1];
+  printf("  %-7s mean %.1f, min %.1f, median %.1f, p90 %.1f, max %.1f\n",
+         name, total / sessionCount * scale, values[0] * scale,
+         values[sessionCount / 2] * scale,
+         values[sessionCount * 9 / 10] * scale, max * scale);
+  uint32_t binWidth = max / HISTOGRAM_BIN_COUNT + 1;
+  uint32_t bins[HISTOGRAM_BIN_COUNT] = {0};
+  uint32_t maxBin = 0;
+  for (uint32_t i = 0; i < sessionCount; i++) {
+    uint32_t *bin = &bins[values[i] / binWidth];
+    (*bin)++;
+    if (*bin > maxBin) {
+      maxBin = *bin;
+    }
+  }
+  for (uint8_t i = 0; i < HISTOGRAM_BIN_COUNT; i++) {
+    printf("    %8.1f - %8.1f %8u ", i * binWidth * scale,
+           (i + 1) * binWidth * scale, bins[i]);
+    for (uint32_t j = 0; j < bins[i] * HISTOGRAM_BAR_WIDTH / maxBin; j++) {
+      putchar('#');
+    }
+    putchar('\n');
+  }
+}
+
+static void printGame(const HostGame *game, const Session *sessions) {
+  uint32_t *values = malloc(sessionCount * sizeof(uint32_t));
+  uint32_t overCount = 0;
+  for (uint32_t i = 0; i < sessionCount; i++) {
+    overCount += sessions[i].isOver;
+  }
+  printf("%s: %u sessions, %u reached the game over\n", game->name,
+         sessionCount, overCount);
+  for (uint32_t i = 0; i < sessionCount; i++) {
+    values[i] = sessions[i].score;
+  }
+  printDistribution("score", values, 1);
+  for (uint32_t i = 0; i < sessionCount; i++) {
+    values[i] = sessions[i].frameCount;
+  }
+  printDistribution("seconds", values, 1.0 / FPS);
+  free(values);
+}
+
+int main(int argc, char *argv[]) {
+  long workerCount = sysconf(_SC_NPROCESSORS_ONLN);
+  int opt;
+  while ((opt = getopt(argc, argv, "s:S:j:l:p:")) != -1) {
+    if (opt == 's') {
+      sessionCount = strtoul(optarg, NULL, 10);
+    } else if (opt == 'S') {
+      firstSeed = strtoul(optarg, NULL, 10);
+    } else if (opt == 'j') {
+      workerCount = strtol(optarg, NULL, 10);
+    } else if (opt == 'l') {
+      maxFrameCount = strtoul(optarg, NULL, 10) * FPS;
+    } else if (opt == 'p' && !strcmp(optarg, "random")) {
+      isRandomPolicy = true;
+    } else if (opt == 'p' && !strcmp(optarg, "scripted")) {
+      isRandomPolicy = false;
+    } else {
+      optind = argc + 1;
+      break;
+    }
+  }
+  if (optind > argc || sessionCount == 0 || workerCount < 1) {
+    fprintf(stderr,
+            "usage: %s [-s sessions] [-S first seed] [-j workers] "
+            "[-l seconds]\n"
+            "       [-p random | scripted] [game...]\n",
+            argv[0]);
+    return 1;
+  }
+  for (const HostGame *game = hostGames; game->name; game++) {
+    if (optind == argc || isHostGameSelected(game, argc - optind,
+                                             argv + optind)) {
+      games[gameCount++] = game;
+    }
+  }
+  size_t batchSize =
+      sizeof(Batch) + (size_t)sessionCount * gameCount * sizeof(Session);
+  Batch *batch = mmap(NULL, batchSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (batch == MAP_FAILED) {
+    perror("mmap");
+    return 1;
+  }
+  atomic_init(&batch->nextSession, 0);
+  double startTime = getTime();
+  for (long i = 0; i < workerCount; i++) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      perror("fork");
+      return 1;
+    }
+    if (pid == 0) {
+      runWorker(batch);
+      _exit(0);
+    }
+  }
+  bool isFailed = false;
+  int status;
+  while (wait(&status) > 0) {
+    isFailed |= !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+  }
+  double time = getTime() - startTime;
+  if (isFailed) {
+    fprintf(stderr, "a worker failed\n");
+    return 1;
+  }
+  for (uint8_t i = 0; i < gameCount; i++) {
+    printGame(games[i], &batch->sessions[i * sessionCount]);
+  }
+  printf("%u sessions in %.2f s by %ld workers, %.0f sessions/s\n",
+         sessionCount * gameCount, time, workerCount,
+         sessionCount * gameCount / time);
+  return 0;
+}
@@ -0,0 +1,65 @@
+// Run the games for a number of frames with scripted input and report the
+// time per frame of each phase.
+//   benchmark [-f frames] [-n] [game...]
+// -n runs the games with disableRendering().
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "cglab.h"
+#include "hostMachine.h"
+#include "hostGames.h"
+#include "scriptedInput.h"
+
+static const char *const phaseNames[PHASE_COUNT] = {
+  "engine", "update", "particles", "scoreBoards", "drawScore", "present",
+  "idle",
+};
+
+static void benchmarkGame(const HostGame *game, uint32_t frameCount) {
+  startHostGame(game, 0);
+  resetHostPhases();
+  for (uint32_t frame = 0; frame < frameCount; frame++) {
+    hostInput = getScriptedInput(frame);
+    updateGame();
+  }
+  int64_t totalNsec = 0;
+  for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+    totalNsec += hostPhaseNsec[i];
+  }
+  printf("%-10s %8u %8.0f", game->name, frameCount,
+         (double)totalNsec / frameCount);
+  for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+    printf(" %11.0f", (double)hostPhaseNsec[i] / frameCount);
+  }
+  printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t frameCount = 10000;
+  int opt;
+  while ((opt = getopt(argc, argv, "f:n")) != -1) {
+    if (opt == 'f') {
+      frameCount = strtoul(optarg, NULL, 10);
+    } else if (opt == 'n') {
+      disableRendering();
+    } else {
+      fprintf(stderr, "usage: %s [-f frames] [-n] [game...]\n", argv[0]);
+      return 1;
+    }
+  }
+  printf("%-10s %8s %8s", "game", "frames", "total");
+  for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+    printf(" %11s", phaseNames[i]);
+  }
+  printf("  (ns/frame)\n");
+  for (const HostGame *game = hostGames; game->name; game++) {
+    if (optind < argc && !isHostGameSelected(game, argc - optind,
+                                             argv + optind)) {
+      continue;
+    }
+    benchmarkGame(game, frameCount);
+  }
+  return 0;
+}
@@ -0,0 +1,292 @@
+// Run the games deterministically with the scripted input, and compare the
+// hashes of the frame buffer and of the collision results of every frame with
+// the golden streams in golden/<game>.txt. The first differing frame is
+// written to <game>-<frame>.pbm.
+//   checkFrames [-f frames] [-d directory] [-u | -n] [-a] [-i | -r] [game...]
+// -u updates the golden streams instead of comparing them. -n runs the games
+// with disableRendering() and compares only the collision results. -a (not with
+// -u) takes the rest of the frame arena after update() in each frame, so that
+// the engine draws its texts from the stack. -i steps the games in turn a frame
+// each, switching their contexts and frame buffers.
+// -r records the scripted input with startInputRecording() instead, and
+// checks that startInputReplay() of the record repeats the same frames.
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cglab.h"
+#include "hostMachine.h"
+#include "hostGames.h"
+#include "scriptedInput.h"
+
+#define FNV_OFFSET_BASIS 2166136261UL
+#define FNV_PRIME        16777619UL
+
+static uint32_t collisionHash;
+static bool isRenderless;
+
+static uint32_t hashBytes(uint32_t hash, const uint8_t *data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ data[i]) * FNV_PRIME;
+  }
+  return hash;
+}
+
+void md_hookCollision(const uint16_t *isColliding) {
+  collisionHash =
+      hashBytes(collisionHash, (const uint8_t *)isColliding,
+                sizeof(((Collision *)NULL)->isColliding));
+}
+
+// Take the rest of the frame arena after update(), and in the frames without
+// it before drawScore().
+static void fillFrameArena(uint8_t phase) {
+  if (phase == PHASE_PARTICLES || phase == PHASE_DRAW_SCORE) {
+    while (frameAlloc(1)) {
+    }
+  }
+}
+
+// A white pixel is 0 (white) in the PBM as it is on the display.
+static void writePbm(const char *path, const uint8_t *screen) {
+  FILE *file = fopen(path, "wb");
+  if (!file) {
+    perror(path);
+    return;
+  }
+  fprintf(file, "P4\n%d %d\n", VIEW_SIZE_X, VIEW_SIZE_Y);
+  for (int16_t y = 0; y < VIEW_SIZE_Y; y++) {
+    for (int16_t x = 0; x < VIEW_SIZE_X; x += 8) {
+      uint8_t v = 0;
+      for (uint8_t i = 0; i < 8; i++) {
+        if (!(screen[x + i + (y / 8) * VIEW_SIZE_X] & bit(y & 7))) {
+          v |= 0x80 >> i;
+        }
+      }
+      fputc(v, file);
+    }
+  }
+  fclose(file);
+}
+
+// A game being checked with its own context and frame buffer.
+typedef struct {
+  const HostGame *game;
+  FILE *file;
+  CglabContext context;
+  uint8_t buffer[HOST_BUFFER_SIZE];
+  uint32_t frameCount;
+  bool isRunning;
+  bool isSame;
+} Check;
+
+static bool openCheck(Check *check, const HostGame *game,
+                      const char *directory, bool isUpdating) {
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s.txt", directory, game->name);
+  memset(check, 0, sizeof(Check));
+  check->game = game;
+  check->file = fopen(path, isUpdating ? "w" : "r");
+  if (!check->file) {
+    perror(path);
+    return false;
+  }
+  loadContext(&check->context);
+  setHostFrameBuffer(check->buffer);
+  if (isRenderless) {
+    disableRendering();
+  }
+  startHostGame(game, 0);
+  saveContext(&check->context);
+  check->isRunning = check->isSame = true;
+  return true;
+}
+
+// Returns whether the check goes on to the next frame.
+static bool stepCheck(Check *check, uint32_t frame, bool isUpdating) {
+  hostInput = getScriptedInput(frame);
+  collisionHash = FNV_OFFSET_BASIS;
+  loadContext(&check->context);
+  setHostFrameBuffer(check->buffer);
+  updateGame();
+  saveContext(&check->context);
+  uint32_t screenHash =
+      hashBytes(FNV_OFFSET_BASIS, hostScreen, sizeof(hostScreen));
+  if (isUpdating) {
+    fprintf(check->file, "%08x %08x\n", screenHash, collisionHash);
+    check->frameCount++;
+    return true;
+  }
+  const char *name = check->game->name;
+  unsigned int goldenScreenHash, goldenCollisionHash;
+  if (fscanf(check->file, "%x %x", &goldenScreenHash,
+             &goldenCollisionHash) != 2) {
+    printf("%s: the golden stream ends at frame %u\n", name, frame);
+    return false;
+  }
+  if ((!isRenderless && screenHash != goldenScreenHash) ||
+      collisionHash != goldenCollisionHash) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s-%u.pbm", name, frame);
+    printf("%s: frame %u differs in the %s, written to %s\n", name, frame,
+           (!isRenderless && screenHash != goldenScreenHash)
+               ? (collisionHash != goldenCollisionHash
+                      ? "frame buffer and the collision results"
+                      : "frame buffer")
+               : "collision results",
+           path);
+    writePbm(path, hostScreen);
+    check->isSame = false;
+    return false;
+  }
+  check->frameCount++;
+  return true;
+}
+
+// Step the games in turn a frame each. Returns whether the streams are the
+// same, or are updated with `isUpdating`.
+static bool runChecks(Check *checks, uint8_t count, uint32_t frameCount,
+                      bool isUpdating) {
+  for (uint32_t frame = 0; frame < frameCount; frame++) {
+    bool isRunning = false;
+    for (uint8_t i = 0; i < count; i++) {
+      Check *check = &checks[i];
+      if (check->isRunning) {
+        check->isRunning = stepCheck(check, frame, isUpdating);
+        isRunning |= check->isRunning;
+      }
+    }
+    if (!isRunning) {
+      break;
+    }
+  }
+  bool isSame = true;
+  for (uint8_t i = 0; i < count; i++) {
+    Check *check = &checks[i];
+    fclose(check->file);
+    if (check->isSame) {
+      printf("%s: %u frames %s\n", check->game->name, check->frameCount,
+             isUpdating ? "written" : "match");
+    }
+    isSame &= check->isSame;
+  }
+  return isSame;
+}
+
+static uint64_t stepFrame(uint32_t input) {
+  hostInput = input;
+  collisionHash = FNV_OFFSET_BASIS;
+  updateGame();
+  uint32_t screenHash =
+      hashBytes(FNV_OFFSET_BASIS, hostScreen, sizeof(hostScreen));
+  return (uint64_t)screenHash << 32 | collisionHash;
+}
+
+// Record a game, play on with other inputs, and replay the record. Returns
+// whether the replay repeats the recorded frames.
+static bool checkReplay(const HostGame *game, uint32_t frameCount) {
+  // The seed and the end mark, and a run of 2 bytes per frame at most.
+  uint32_t recordSize = 5 + frameCount * 2;
+  uint8_t *record = malloc(recordSize);
+  uint64_t *hashes = malloc(frameCount * sizeof(uint64_t));
+  static CglabContext context;
+  static uint8_t buffer[HOST_BUFFER_SIZE];
+  memset(&context, 0, sizeof(context));
+  loadContext(&context);
+  setHostFrameBuffer(buffer);
+  if (isRenderless) {
+    disableRendering();
+  }
+  startHostGame(game, 0);
+  startInputRecording(record, recordSize > 0xFFFF ? 0xFFFF : recordSize);
+  for (uint32_t frame = 0; frame < frameCount; frame++) {
+    hashes[frame] = stepFrame(getScriptedInput(frame));
+  }
+  uint16_t size = stopInputRecording();
+  bool isSame = size > 0;
+  if (!isSame) {
+    printf("%s: the record of %u frames doesn't fit in %u bytes\n",
+           game->name, frameCount, recordSize);
+  }
+  for (uint32_t frame = 0; frame < frameCount && isSame; frame++) {
+    stepFrame(getScriptedInput(frame * 3 + 1));
+  }
+  startInputReplay(record);
+  for (uint32_t frame = 0; frame < frameCount && isSame; frame++) {
+    if (stepFrame(getScriptedInput(frame * 3 + 2)) != hashes[frame]) {
+      printf("%s: frame %u of the replay differs\n", game->name, frame);
+      isSame = false;
+    }
+  }
+  if (isSame) {
+    printf("%s: %u frames replayed from %u bytes\n", game->name, frameCount,
+           size);
+  }
+  free(hashes);
+  free(record);
+  return isSame;
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t frameCount = 3000;
+  const char *directory = "golden";
+  bool isUpdating = false;
+  bool isInterleaved = false;
+  bool isReplaying = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "f:d:unair")) != -1) {
+    if (opt == 'f') {
+      frameCount = strtoul(optarg, NULL, 10);
+    } else if (opt == 'd') {
+      directory = optarg;
+    } else if (opt == 'u') {
+      isUpdating = true;
+    } else if (opt == 'n') {
+      isRenderless = true;
+    } else if (opt == 'a') {
+      hostPhaseHook = fillFrameArena;
+    } else if (opt == 'i') {
+      isInterleaved = true;
+    } else if (opt == 'r') {
+      isReplaying = true;
+    } else {
+      optind = argc + 1;
+      break;
+    }
+  }
+  if (optind > argc || (isUpdating && (isRenderless || hostPhaseHook)) ||
+      (isReplaying && (isUpdating || isInterleaved))) {
+    fprintf(stderr,
+            "usage: %s [-f frames] [-d directory] [-u | -n] [-a] "
+            "[-i | -r] [game...]\n",
+            argv[0]);
+    return 1;
+  }
+  static Check checks[HOST_GAME_COUNT];
+  uint8_t count = 0;
+  bool isSame = true;
+  for (const HostGame *game = hostGames; game->name; game++) {
+    if (optind < argc && !isHostGameSelected(game, argc - optind,
+                                             argv + optind)) {
+      continue;
+    }
+    if (isReplaying) {
+      isSame &= checkReplay(game, frameCount);
+      continue;
+    }
+    Check *check = &checks[isInterleaved ? count : 0];
+    if (!openCheck(check, game, directory, isUpdating)) {
+      isSame = false;
+    } else if (isInterleaved) {
+      count++;
+    } else {
+      isSame &= runChecks(check, 1, frameCount, isUpdating);
+    }
+  }
+  if (isInterleaved) {
+    isSame &= runChecks(checks, count, frameCount, isUpdating);
+  }
+  return isSame ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// Compare findPairsWithin() with testing all the pairs by withinDistance() on
+// random sets of entities, with ties on x and as many pairs as fit.
+//   checkProximity [-s sets]
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "proximity.h"
+#include "random.h"
+
+#define MAX_ENTITY_COUNT 64
+#define MAX_PAIR_COUNT   (MAX_ENTITY_COUNT * (MAX_ENTITY_COUNT - 1) / 2)
+
+// An entity with the position in the middle, as in the games.
+typedef struct {
+  uint8_t type;
+  Vector pos;
+  bool isAlive;
+} Entity;
+
+static Random proximityRandom;
+
+static Number getRandomCoordinate(uint8_t range) {
+  // Whole numbers half of the time, so that items tie on x.
+  if (randomNext(&proximityRandom) & 1) {
+    return NUM((int16_t)(randomNext(&proximityRandom) % range));
+  }
+  return NUM((int16_t)(randomNext(&proximityRandom) % range)) +
+         NUM((int16_t)(randomNext(&proximityRandom) % 256)) / 256;
+}
+
+static int comparePairs(const void *a, const void *b) {
+  const ProximityPair *p = a, *q = b;
+  return (p->i != q->i) ? p->i - q->i : p->j - q->j;
+}
+
+static uint16_t findAllPairs(Entity *entities, uint8_t count, Number distance,
+                             ProximityPair *pairs) {
+  uint16_t pairCount = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    for (uint8_t j = i + 1; j < count; j++) {
+      if (withinDistance(&entities[i].pos, VEC_XY(entities[j].pos),
+                         distance)) {
+        pairs[pairCount].i = i;
+        pairs[pairCount].j = j;
+        pairCount++;
+      }
+    }
+  }
+  return pairCount;
+}
+
+// Returns whether the pairs of a random set are the same both ways.
+static bool checkSet(uint32_t set) {
+  static Entity entities[MAX_ENTITY_COUNT];
+  static uint8_t order[MAX_ENTITY_COUNT];
+  static ProximityPair pairs[MAX_PAIR_COUNT], allPairs[MAX_PAIR_COUNT];
+  uint8_t count = randomNext(&proximityRandom) % (MAX_ENTITY_COUNT + 1);
+  uint8_t range = 4 + randomNext(&proximityRandom) % 124;
+  Number distance = getRandomCoordinate(16);
+  for (uint8_t i = 0; i < count; i++) {
+    vectorSet(&entities[i].pos, getRandomCoordinate(range),
+              getRandomCoordinate(range));
+  }
+  uint16_t allCount = findAllPairs(entities, count, distance, allPairs);
+  // Also with fewer places for the pairs than the pairs found.
+  uint8_t maxPairCount =
+      (set % 4 == 0 && allCount / 2 < 255) ? allCount / 2 : 255;
+  uint8_t pairCount = findPairsWithin(&entities[0].pos, count, sizeof(Entity),
+                                      distance, order, pairs, maxPairCount);
+  uint16_t expectedCount = allCount < maxPairCount ? allCount : maxPairCount;
+  if (pairCount != expectedCount) {
+    printf("set %u: %u pairs instead of %u\n", set, pairCount, expectedCount);
+    return false;
+  }
+  if (maxPairCount < allCount) {
+    // The found pairs are some of all the pairs.
+    for (uint8_t i = 0; i < pairCount; i++) {
+      if (!bsearch(&pairs[i], allPairs, allCount, sizeof(ProximityPair),
+                   comparePairs)) {
+        printf("set %u: (%u, %u) is not a pair\n", set, pairs[i].i,
+               pairs[i].j);
+        return false;
+      }
+    }
+    return true;
+  }
+  qsort(pairs, pairCount, sizeof(ProximityPair), comparePairs);
+  if (memcmp(pairs, allPairs, pairCount * sizeof(ProximityPair))) {
+    printf("set %u: the pairs differ\n", set);
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t setCount = 10000;
+  int opt;
+  while ((opt = getopt(argc, argv, "s:")) != -1) {
+    if (opt == 's') {
+      setCount = strtoul(optarg, NULL, 10);
+    } else {
+      fprintf(stderr, "usage: %s [-s sets]\n", argv[0]);
+      return 1;
+    }
+  }
+  randomSetSeed(&proximityRandom, 1);
+  for (uint32_t set = 0; set < setCount; set++) {
+    if (!checkSet(set)) {
+      return 1;
+    }
+  }
+  printf("findPairsWithin: %u sets match\n", setCount);
+  return 0;
+}
@@ -0,0 +1,318 @@
+// Search for the input which makes the most expensive frame of the games, and
+// write a minimized replay of each new worst frame for the cycle benchmark.
+//   fuzzFrames [-r runs] [-f frames] [-o directory] [-S seed] [game...]
+// The cost of a frame is the number of the hit box tests and the draw calls.
+// An input is a game index byte, a random seed (4 bytes, little endian) and
+// an input state byte for each frame. It is played as a record of
+// startInputReplay(), so the replay written to <directory>/<Game>-worst.h
+// plays the same frames on the Arduboy. With CGLAB_TRACE, the trace of the
+// frames up to the worst one is written to <directory>/<Game>-worst.csv.
+// Built with CGLAB_LIBFUZZER (make fuzzFramesLibFuzzer), this is a libFuzzer
+// target whose extra counters are the buckets of the worst cost, instead of
+// the driver below which mutates the inputs of the last new worst frames.
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cglab.h"
+#include "hostMachine.h"
+#include "hostGames.h"
+#include "random.h"
+
+#define FUZZ_HEADER_SIZE 5
+#define MAX_FUZZ_FRAME_COUNT 3600
+#define INPUT_MASK \
+  (INPUT_LEFT | INPUT_RIGHT | INPUT_UP | INPUT_DOWN | INPUT_A | INPUT_B)
+// Runs of a frame input merged into the previous one at most in minimizing.
+#define MAX_MINIMIZE_TRIAL_COUNT 256
+
+typedef struct {
+  uint32_t cost;
+  uint32_t frame;
+  uint32_t hitBoxTestCount;
+  uint32_t drawCallCount;
+} WorstFrame;
+
+static uint32_t hitBoxTestCount;
+static uint8_t replay[4 + MAX_FUZZ_FRAME_COUNT * 2 + 1];
+static uint32_t worstCosts[HOST_GAME_COUNT];
+static const char *directory = ".";
+
+void md_hookHitBoxTests(uint8_t count) {
+  hitBoxTestCount += count;
+}
+
+static uint32_t getFrameCount(size_t size) {
+  uint32_t frameCount = size - FUZZ_HEADER_SIZE;
+  return frameCount < MAX_FUZZ_FRAME_COUNT ? frameCount : MAX_FUZZ_FRAME_COUNT;
+}
+
+// The record of startInputRecording() with the runs of the frame inputs.
+static uint16_t makeReplay(const uint8_t *data, size_t size) {
+  memcpy(replay, data + 1, 4);
+  uint16_t index = 4;
+  uint32_t frameCount = getFrameCount(size);
+  for (uint32_t i = 0; i < frameCount;) {
+    uint8_t input = data[FUZZ_HEADER_SIZE + i] & INPUT_MASK;
+    uint8_t count = 0;
+    while (i < frameCount && count < 0xFF &&
+           (data[FUZZ_HEADER_SIZE + i] & INPUT_MASK) == input) {
+      count++;
+      i++;
+    }
+    replay[index++] = count;
+    replay[index++] = input;
+  }
+  replay[index++] = 0;
+  return index;
+}
+
+static const HostGame *getFuzzGame(const uint8_t *data) {
+  return &hostGames[data[0] % HOST_GAME_COUNT];
+}
+
+static WorstFrame runFuzzInput(const uint8_t *data, size_t size) {
+  WorstFrame worst = {0, 0, 0, 0};
+  makeReplay(data, size);
+  startHostGame(getFuzzGame(data), 0);
+  startInputReplay(replay);
+  hostInput = 0;
+  uint32_t frameCount = getFrameCount(size);
+  for (uint32_t frame = 0; frame < frameCount; frame++) {
+    hitBoxTestCount = hostDrawCallCount = 0;
+    updateGame();
+    uint32_t cost = hitBoxTestCount + hostDrawCallCount;
+    if (cost > worst.cost) {
+      worst.cost = cost;
+      worst.frame = frame;
+      worst.hitBoxTestCount = hitBoxTestCount;
+      worst.drawCallCount = hostDrawCallCount;
+    }
+  }
+  return worst;
+}
+
+// Drop the frames after the worst one, and merge each run of the frame inputs
+// into the previous one while the worst frame costs as much. Returns the size.
+static size_t minimizeFuzzInput(uint8_t *data, uint32_t frame,
+                                uint32_t cost) {
+  size_t size = FUZZ_HEADER_SIZE + frame + 1;
+  for (size_t i = FUZZ_HEADER_SIZE; i < size; i++) {
+    data[i] &= INPUT_MASK;
+  }
+  uint16_t trialCount = 0;
+  size_t i = FUZZ_HEADER_SIZE + 1;
+  while (i < size && trialCount < MAX_MINIMIZE_TRIAL_COUNT) {
+    uint8_t input = data[i];
+    size_t end = i;
+    while (end < size && data[end] == input) {
+      end++;
+    }
+    if (input != data[i - 1]) {
+      memset(data + i, data[i - 1], end - i);
+      trialCount++;
+      if (runFuzzInput(data, size).cost < cost) {
+        memset(data + i, input, end - i);
+      }
+    }
+    i = end;
+  }
+  return size;
+}
+
+static void writeReplay(const uint8_t *data, size_t size,
+                        const WorstFrame *worst) {
+  const char *name = getFuzzGame(data)->name;
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s-worst.h", directory, name);
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    perror(path);
+    return;
+  }
+  uint16_t replaySize = makeReplay(data, size);
+  fprintf(file,
+          "// %s: frame %u costs %u, %u hit box tests and %u draw calls.\n"
+          "// Play it with startInputReplay(worstReplay) after initGame().\n"
+          "PROGMEM static const uint8_t worstReplay[%u] = {",
+          name, worst->frame, worst->cost, worst->hitBoxTestCount,
+          worst->drawCallCount, replaySize);
+  for (uint16_t i = 0; i < replaySize; i++) {
+    fprintf(file, "%s0x%02X,", (i % 12) ? " " : "\n  ", replay[i]);
+  }
+  fprintf(file, "\n};\n");
+  fclose(file);
+  printf("%s: frame %u costs %u (%u hit box tests, %u draw calls), "
+         "%u bytes of replay in %s\n",
+         name, worst->frame, worst->cost, worst->hitBoxTestCount,
+         worst->drawCallCount, replaySize, path);
+#ifdef CGLAB_TRACE
+  // The minimized input ends at the worst frame, and so does the trace.
+  snprintf(path, sizeof(path), "%s/%s-worst.csv", directory, name);
+  hostTraceFile = fopen(path, "w");
+  if (!hostTraceFile) {
+    perror(path);
+    return;
+  }
+  runFuzzInput(data, size);
+  dumpTrace();
+  fclose(hostTraceFile);
+  hostTraceFile = NULL;
+#endif
+}
+
+// Returns the worst frame of the input, and writes the replay of it when it
+// is the worst of the game so far.
+static WorstFrame checkFuzzInput(const uint8_t *data, size_t size) {
+  WorstFrame worst = runFuzzInput(data, size);
+  uint32_t *worstCost = &worstCosts[data[0] % HOST_GAME_COUNT];
+  if (worst.cost > *worstCost) {
+    uint8_t *minimized = malloc(size);
+    memcpy(minimized, data, size);
+    size_t minimizedSize = minimizeFuzzInput(minimized, worst.frame,
+                                             worst.cost);
+    // Merging the runs can make a frame even more expensive.
+    WorstFrame minimizedWorst = runFuzzInput(minimized, minimizedSize);
+    *worstCost = minimizedWorst.cost;
+    writeReplay(minimized, minimizedSize, &minimizedWorst);
+    free(minimized);
+  }
+  return worst;
+}
+
+#ifdef CGLAB_LIBFUZZER
+
+#define COST_COUNTER_COUNT 256
+#define COST_BUCKET_SIZE 8
+
+__attribute__((section("__libfuzzer_extra_counters")))
+static uint8_t costCounters[COST_COUNTER_COUNT];
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  if (size <= FUZZ_HEADER_SIZE) {
+    return 0;
+  }
+  WorstFrame worst = checkFuzzInput(data, size);
+  uint32_t bucket = worst.cost / COST_BUCKET_SIZE;
+  costCounters[bucket < COST_COUNTER_COUNT ? bucket
+                                           : COST_COUNTER_COUNT - 1] = 1;
+  return 0;
+}
+
+#else
+
+#define CORPUS_SIZE 16
+
+static Random fuzzRandom;
+
+static uint32_t getRandom(uint32_t range) {
+  return randomNext(&fuzzRandom) % range;
+}
+
+// Frame inputs held for 1 to 32 frames.
+static void randomizeFrames(uint8_t *data, size_t from, size_t to) {
+  while (from < to) {
+    size_t end = from + 1 + getRandom(32);
+    memset(data + from, randomNext(&fuzzRandom) & INPUT_MASK,
+           (end < to ? end : to) - from);
+    from = end;
+  }
+}
+
+static void mutate(uint8_t *data, size_t size) {
+  size_t frameCount = size - FUZZ_HEADER_SIZE;
+  switch (getRandom(4)) {
+    case 0:
+      data[1 + getRandom(4)] = randomNext(&fuzzRandom);
+      break;
+    case 1:
+      data[FUZZ_HEADER_SIZE + getRandom(frameCount)] ^= bit(2 + getRandom(6));
+      break;
+    case 2: {
+      size_t from = FUZZ_HEADER_SIZE + getRandom(frameCount);
+      randomizeFrames(data, from, from + 1 + getRandom(size - from));
+      break;
+    }
+    default: {
+      // Move a run of up to a quarter of the frames, or a frame.
+      size_t length = 1 + (frameCount >= 4 ? getRandom(frameCount / 4) : 0);
+      size_t from = FUZZ_HEADER_SIZE + getRandom(frameCount - length + 1);
+      size_t to = FUZZ_HEADER_SIZE + getRandom(frameCount - length + 1);
+      memmove(data + to, data + from, length);
+      break;
+    }
+  }
+}
+
+// Mutate the inputs which made the last new worst frames of the game.
+static void fuzzGame(uint8_t gameIndex, uint32_t runCount,
+                     uint32_t frameCount) {
+  size_t size = FUZZ_HEADER_SIZE + frameCount;
+  static uint8_t corpus[CORPUS_SIZE][FUZZ_HEADER_SIZE + MAX_FUZZ_FRAME_COUNT];
+  uint8_t corpusCount = 0, corpusIndex = 0;
+  uint8_t data[FUZZ_HEADER_SIZE + MAX_FUZZ_FRAME_COUNT];
+  uint32_t worstCost = 0;
+  for (uint32_t run = 0; run < runCount; run++) {
+    if (corpusCount == 0 || getRandom(8) == 0) {
+      data[0] = gameIndex;
+      for (uint8_t i = 1; i < FUZZ_HEADER_SIZE; i++) {
+        data[i] = randomNext(&fuzzRandom);
+      }
+      randomizeFrames(data, FUZZ_HEADER_SIZE, size);
+    } else {
+      memcpy(data, corpus[getRandom(corpusCount)], size);
+      for (uint8_t i = getRandom(4); i < 4; i++) {
+        mutate(data, size);
+      }
+    }
+    WorstFrame worst = checkFuzzInput(data, size);
+    if (worst.cost > worstCost) {
+      worstCost = worst.cost;
+      memcpy(corpus[corpusIndex], data, size);
+      corpusIndex = (corpusIndex + 1) % CORPUS_SIZE;
+      if (corpusCount < CORPUS_SIZE) {
+        corpusCount++;
+      }
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t runCount = 2000;
+  uint32_t frameCount = 1800;
+  uint32_t seed = 1;
+  int opt;
+  while ((opt = getopt(argc, argv, "r:f:o:S:")) != -1) {
+    if (opt == 'r') {
+      runCount = strtoul(optarg, NULL, 10);
+    } else if (opt == 'f') {
+      frameCount = strtoul(optarg, NULL, 10);
+    } else if (opt == 'o') {
+      directory = optarg;
+    } else if (opt == 'S') {
+      seed = strtoul(optarg, NULL, 10);
+    } else {
+      optind = argc + 1;
+      break;
+    }
+  }
+  if (optind > argc || frameCount < 1 || frameCount > MAX_FUZZ_FRAME_COUNT) {
+    fprintf(stderr,
+            "usage: %s [-r runs] [-f frames (1-%u)] [-o directory] [-S seed] "
+            "[game...]\n",
+            argv[0], MAX_FUZZ_FRAME_COUNT);
+    return 1;
+  }
+  randomSetSeed(&fuzzRandom, seed);
+  for (uint8_t i = 0; i < HOST_GAME_COUNT; i++) {
+    if (optind == argc || isHostGameSelected(&hostGames[i], argc - optind,
+                                             argv + optind)) {
+      fuzzGame(i, runCount, frameCount);
+    }
+  }
+  return 0;
+}
+
+#endif
@@ -0,0 +1,315 @@
+#define _GNU_SOURCE
+#include "hostAudio.h"
+
+#include <Arduino.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#include "machineDependent.h"
+#include "noteTimer.h"
+#include "soundSequence.h"
+
+#define SAMPLE_RATE         44100
+#define BLOCK_SAMPLE_COUNT  256
+#define PREFILL_BLOCK_COUNT 2
+#define CHANNEL_COUNT       2
+#define AMPLITUDE           8192
+#define EVENT_QUEUE_SIZE    64 // power of 2
+
+#define NSEC_PER_SEC 1000000000LL
+#define BLOCK_NSEC   (NSEC_PER_SEC * BLOCK_SAMPLE_COUNT / SAMPLE_RATE)
+
+typedef struct {
+  const uint8_t *sound;
+  int64_t time;
+  uint32_t generation;
+  uint8_t channel;
+  bool isStop;
+} AudioEvent;
+
+typedef struct {
+  SoundSequence sequence;
+  uint32_t generation;
+  double phase;
+  double phaseStep; // 0 while resting
+} Channel;
+
+/*  Single-producer/single-consumer ring. Only the game thread writes
+ *  `eventHead` and only the synthesis thread writes `eventTail`.  */
+static AudioEvent events[EVENT_QUEUE_SIZE];
+static atomic_uint eventHead;
+static atomic_uint eventTail;
+
+// A sound is playing while its generation isn't finished by the synthesis
+// thread yet, so that md_isSoundPlaying() doesn't need a lock.
+static atomic_uint requestedGenerations[CHANNEL_COUNT];
+static atomic_uint finishedGenerations[CHANNEL_COUNT];
+
+static atomic_bool isRunning;
+static atomic_bool isSoundEnabled = true;
+static bool isOpen;
+static pthread_t thread;
+static FILE *wavFile;
+static Channel channels[CHANNEL_COUNT];
+
+static struct {
+  uint32_t blockCount;
+  uint32_t underrunCount;
+  int64_t totalRenderNsec;
+  int64_t maxRenderNsec;
+  uint32_t playCount;
+  uint32_t stopCount;
+  atomic_uint droppedCount;
+  int64_t totalLatencyNsec;
+  int64_t minLatencyNsec;
+  int64_t maxLatencyNsec;
+} stats;
+
+static int64_t getTime(clockid_t clock) {
+  struct timespec ts;
+  clock_gettime(clock, &ts);
+  return ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static bool pushEvent(const AudioEvent *event) {
+  unsigned head = atomic_load_explicit(&eventHead, memory_order_relaxed);
+  unsigned tail = atomic_load_explicit(&eventTail, memory_order_acquire);
+  if (head - tail >= EVENT_QUEUE_SIZE) {
+    return false;
+  }
+  events[head & (EVENT_QUEUE_SIZE - 1)] = *event;
+  atomic_store_explicit(&eventHead, head + 1, memory_order_release);
+  return true;
+}
+
+static bool popEvent(AudioEvent *event) {
+  unsigned tail = atomic_load_explicit(&eventTail, memory_order_relaxed);
+  unsigned head = atomic_load_explicit(&eventHead, memory_order_acquire);
+  if (tail == head) {
+    return false;
+  }
+  *event = events[tail & (EVENT_QUEUE_SIZE - 1)];
+  atomic_store_explicit(&eventTail, tail + 1, memory_order_release);
+  return true;
+}
+
+static void requestSound(uint8_t chan, const uint8_t *sound, bool isStop) {
+  if (!isOpen) {
+    return;
+  }
+  uint32_t generation = atomic_load(&requestedGenerations[chan]) + 1;
+  AudioEvent event = {sound, getTime(CLOCK_MONOTONIC), generation,
+                      chan, isStop};
+  if (!pushEvent(&event)) {
+    atomic_fetch_add(&stats.droppedCount, 1);
+    return;
+  }
+  atomic_store(&requestedGenerations[chan], generation);
+}
+
+void md_playSound(const uint8_t *sound, bool isBgm) {
+  requestSound(isBgm ? 1 : 0, sound, false);
+}
+
+void md_stopSound(bool isBgm) {
+  requestSound(isBgm ? 1 : 0, NULL, true);
+}
+
+bool md_isSoundPlaying(bool isBgm) {
+  uint8_t chan = isBgm ? 1 : 0;
+  return atomic_load(&requestedGenerations[chan]) !=
+         atomic_load(&finishedGenerations[chan]);
+}
+
+bool md_getSoundEnabled(void) {
+  return atomic_load(&isSoundEnabled);
+}
+
+void md_setSoundEnabled(bool isEnabled) {
+  atomic_store(&isSoundEnabled, isEnabled);
+}
+
+void md_saveSoundEnabled(void) {}
+
+/*---------------------------------------------------------------------------*/
+
+// The frequency that the Arduboy plays, from the same timer table.
+static double getNoteFrequency(uint8_t note) {
+  if (note > 127) {
+    return 0;
+  }
+  long prescaler = (note < NOTE_PRESCALER64_COUNT) ? 64 : 1;
+  uint16_t ocr = pgm_read_word(&midiNoteTimerOcr[note]);
+  return (double)F_CPU / prescaler / (ocr + 1) / 2;
+}
+
+static void forwardChannel(uint8_t chan) {
+  Channel *channel = &channels[chan];
+  double frequency = 0;
+  if (forwardSoundSequence(&channel->sequence) == SOUND_SEQUENCE_NOTE) {
+    frequency = getNoteFrequency(channel->sequence.note);
+  }
+  channel->phaseStep = frequency / SAMPLE_RATE;
+  if (!channel->sequence.data) {
+    atomic_store(&finishedGenerations[chan], channel->generation);
+  }
+}
+
+static void applyEvent(const AudioEvent *event, uint16_t now,
+                       int64_t playTime) {
+  Channel *channel = &channels[event->channel];
+  channel->generation = event->generation;
+  channel->phaseStep = 0;
+  if (event->isStop) {
+    channel->sequence.data = NULL;
+    atomic_store(&finishedGenerations[event->channel], event->generation);
+    stats.stopCount++;
+    return;
+  }
+  startSoundSequence(&channel->sequence, event->sound, now);
+  forwardChannel(event->channel);
+  stats.playCount++;
+  int64_t latency = playTime - event->time;
+  stats.totalLatencyNsec += latency;
+  if (stats.playCount == 1 || latency < stats.minLatencyNsec) {
+    stats.minLatencyNsec = latency;
+  }
+  if (latency > stats.maxLatencyNsec) {
+    stats.maxLatencyNsec = latency;
+  }
+}
+
+static void writeLe(uint32_t v, uint8_t size) {
+  for (uint8_t i = 0; i < size; i++) {
+    fputc((v >> (i * 8)) & 0xFF, wavFile);
+  }
+}
+
+static void writeWavHeader(uint32_t sampleCount) {
+  uint32_t dataSize = sampleCount * 2;
+  fseek(wavFile, 0, SEEK_SET);
+  fwrite("RIFF", 1, 4, wavFile);
+  writeLe(36 + dataSize, 4);
+  fwrite("WAVEfmt ", 1, 8, wavFile);
+  writeLe(16, 4);
+  writeLe(1, 2); // PCM
+  writeLe(1, 2); // mono
+  writeLe(SAMPLE_RATE, 4);
+  writeLe(SAMPLE_RATE * 2, 4);
+  writeLe(2, 2);
+  writeLe(16, 2);
+  fwrite("data", 1, 4, wavFile);
+  writeLe(dataSize, 4);
+}
+
+/*  Block k is rendered from startTime + k blocks and is played from
+ *  startTime + (k + PREFILL_BLOCK_COUNT) blocks, as a sound device with a
+ *  two-block buffer would. A block not rendered until then is an underrun.
+ *  Events are applied at the start of the first block rendered after them.  */
+static void *renderAudio(void *arg) {
+  (void)arg;
+  int16_t samples[BLOCK_SAMPLE_COUNT];
+  int64_t startTime = getTime(CLOCK_MONOTONIC);
+  uint64_t sampleIndex = 0;
+  uint16_t now = 0;
+  uint32_t msecRemainder = 0;
+  for (uint32_t block = 0; atomic_load(&isRunning); block++) {
+    int64_t renderTime = startTime + block * BLOCK_NSEC;
+    struct timespec ts = {renderTime / NSEC_PER_SEC,
+                          renderTime % NSEC_PER_SEC};
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    int64_t playTime = renderTime + PREFILL_BLOCK_COUNT * BLOCK_NSEC;
+    int64_t cpuTime = getTime(CLOCK_THREAD_CPUTIME_ID);
+    AudioEvent event;
+    while (popEvent(&event)) {
+      applyEvent(&event, now, playTime);
+    }
+    bool isEnabled = atomic_load(&isSoundEnabled);
+    for (int i = 0; i < BLOCK_SAMPLE_COUNT; i++, sampleIndex++) {
+      msecRemainder += 1000;
+      if (msecRemainder >= SAMPLE_RATE) {
+        msecRemainder -= SAMPLE_RATE;
+        now++;
+        for (uint8_t chan = 0; chan < CHANNEL_COUNT; chan++) {
+          SoundSequence *sequence = &channels[chan].sequence;
+          while (sequence->data &&
+                 (int16_t)(now - sequence->eventTime) >= 0) {
+            forwardChannel(chan);
+          }
+        }
+      }
+      int32_t v = 0;
+      for (uint8_t chan = 0; chan < CHANNEL_COUNT; chan++) {
+        Channel *channel = &channels[chan];
+        if (channel->phaseStep > 0) {
+          v += channel->phase < 0.5 ? AMPLITUDE : -AMPLITUDE;
+          channel->phase += channel->phaseStep;
+          channel->phase -= (int)channel->phase;
+        }
+      }
+      samples[i] = isEnabled ? v : 0;
+    }
+    int64_t renderNsec = getTime(CLOCK_THREAD_CPUTIME_ID) - cpuTime;
+    fwrite(samples, sizeof(int16_t), BLOCK_SAMPLE_COUNT, wavFile);
+    stats.blockCount++;
+    stats.totalRenderNsec += renderNsec;
+    if (renderNsec > stats.maxRenderNsec) {
+      stats.maxRenderNsec = renderNsec;
+    }
+    if (getTime(CLOCK_MONOTONIC) > playTime) {
+      stats.underrunCount++;
+    }
+  }
+  writeWavHeader(sampleIndex);
+  return NULL;
+}
+
+bool openHostAudio(const char *wavPath) {
+  wavFile = fopen(wavPath, "wb");
+  if (!wavFile) {
+    return false;
+  }
+  writeWavHeader(0);
+  atomic_store(&isRunning, true);
+  if (pthread_create(&thread, NULL, renderAudio, NULL) != 0) {
+    fclose(wavFile);
+    return false;
+  }
+  isOpen = true;
+  return true;
+}
+
+void closeHostAudio(void) {
+  if (!isOpen) {
+    return;
+  }
+  atomic_store(&isRunning, false);
+  pthread_join(thread, NULL);
+  fclose(wavFile);
+  isOpen = false;
+}
+
+void printHostAudioReport(FILE *file) {
+  double blockMsec = (double)BLOCK_NSEC / 1e6;
+  fprintf(file, "audio: %d Hz, %d samples/block (%.2f ms), %d blocks ahead\n",
+          SAMPLE_RATE, BLOCK_SAMPLE_COUNT, blockMsec, PREFILL_BLOCK_COUNT);
+  if (stats.blockCount > 0) {
+    double avgUsec = stats.totalRenderNsec / 1e3 / stats.blockCount;
+    fprintf(file,
+            "blocks: %u rendered, %u underruns, render avg %.1f us "
+            "(%.2f%% of real time), max %.1f us\n",
+            stats.blockCount, stats.underrunCount, avgUsec,
+            avgUsec / 10 / blockMsec, stats.maxRenderNsec / 1e3);
+  }
+  fprintf(file, "events: %u played, %u stopped, %u dropped (queue full)\n",
+          stats.playCount, stats.stopCount, atomic_load(&stats.droppedCount));
+  if (stats.playCount > 0) {
+    double avgMsec = stats.totalLatencyNsec / 1e6 / stats.playCount;
+    fprintf(file,
+            "onset latency: min %.2f ms, avg %.2f ms, max %.2f ms "
+            "(max %.2f ticks)\n",
+            stats.minLatencyNsec / 1e6, avgMsec, stats.maxLatencyNsec / 1e6,
+            stats.maxLatencyNsec / 1e6 * FPS / 1000);
+  }
+}
@@ -0,0 +1,15 @@
+// Audio part of the machine dependent functions for the host. The game thread
+// sends the md_playSound()/md_stopSound() requests through a lock-free queue to
+// a synthesis thread, which plays the patterns with the same sequencer as the
+// Arduboy and renders square waves into a WAV file in real time.
+#ifndef HOST_AUDIO_H
+#define HOST_AUDIO_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+bool openHostAudio(const char *wavPath);
+void closeHostAudio(void);
+void printHostAudioReport(FILE *file);
+
+#endif
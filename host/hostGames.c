@@ -0,0 +1,38 @@
+#include "hostGames.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+#include "cglab.h"
+
+void setupGameBallTour(void);
+void setupGamePakuPaku(void);
+void setupGamePinClimb(void);
+void setupGameSurvivor(void);
+
+const HostGame hostGames[HOST_GAME_COUNT + 1] = {
+  {"BallTour", setupGameBallTour},
+  {"PakuPaku", setupGamePakuPaku},
+  {"PinClimb", setupGamePinClimb},
+  {"Survivor", setupGameSurvivor},
+  {NULL, NULL},
+};
+
+bool isHostGameSelected(const HostGame *game, int nameCount,
+                        char *const names[]) {
+  if (nameCount == 0) {
+    return true;
+  }
+  for (int i = 0; i < nameCount; i++) {
+    if (!strcmp(game->name, names[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void startHostGame(const HostGame *game, uint32_t seed) {
+  game->setup();
+  initGame();
+  setRandomSeed(seed);
+}
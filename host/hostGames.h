@@ -0,0 +1,24 @@
+// The games linked into the host tools, and scripted input to play them.
+#ifndef HOST_GAMES_H
+#define HOST_GAMES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+  const char *name;
+  void (*setup)(void);
+} HostGame;
+
+#define HOST_GAME_COUNT 4
+
+// Terminated by an entry with NULL `name`.
+extern const HostGame hostGames[HOST_GAME_COUNT + 1];
+
+// Whether `game` is named in `names`, or `nameCount` is 0.
+bool isHostGameSelected(const HostGame *game, int nameCount,
+                        char *const names[]);
+// Set up and initialize `game` with the random seed `seed`.
+void startHostGame(const HostGame *game, uint32_t seed);
+
+#endif
@@ -0,0 +1,192 @@
+#define _GNU_SOURCE
+#include "hostMachine.h"
+
+#include <Arduino.h>
+#include <string.h>
+#include <time.h>
+
+#include "frameBuffer.h"
+
+#define NSEC_PER_SEC 1000000000LL
+
+uint8_t hostInput;
+uint8_t hostScreen[HOST_BUFFER_SIZE];
+int64_t hostPhaseNsec[PHASE_COUNT];
+void (*hostPhaseHook)(uint8_t phase);
+uint32_t hostDrawCallCount;
+FILE *hostTraceFile;
+
+static uint8_t machineBuffer[HOST_BUFFER_SIZE];
+static uint8_t *buffer = machineBuffer;
+static bool isPacing;
+static bool isOverrun;
+static int64_t nextFrameTime;
+
+static int64_t getTime(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+void setHostFramePacing(bool _isPacing) {
+  isPacing = _isPacing;
+  isOverrun = false;
+  nextFrameTime = getTime();
+}
+
+void setHostFrameBuffer(uint8_t *_buffer) {
+  buffer = _buffer ? _buffer : machineBuffer;
+}
+
+void md_initMachine(void) {
+  memset(buffer, 0, HOST_BUFFER_SIZE);
+  memset(hostScreen, 0, sizeof(hostScreen));
+}
+
+// A frame after an overrun starts at once as Arduboy2Base::nextFrame() does.
+bool md_nextFrame(void) {
+  if (isPacing) {
+    int64_t now = getTime();
+    isOverrun = now > nextFrameTime;
+    if (isOverrun) {
+      nextFrameTime = now;
+    } else {
+      struct timespec ts = {
+        .tv_sec = nextFrameTime / NSEC_PER_SEC,
+        .tv_nsec = nextFrameTime % NSEC_PER_SEC,
+      };
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+    nextFrameTime += NSEC_PER_SEC / FPS;
+  }
+  return true;
+}
+
+bool md_isFrameOverrun(void) {
+  return isOverrun;
+}
+
+void md_refresh(void) {
+  memcpy(hostScreen, buffer, HOST_BUFFER_SIZE);
+}
+
+void md_clearView(void) {
+  memset(buffer, 0, HOST_BUFFER_SIZE);
+}
+
+static const uint8_t colorTable[] = {
+  FRAME_BUFFER_BLACK, FRAME_BUFFER_BLACK, FRAME_BUFFER_BLACK,
+  FRAME_BUFFER_WHITE, FRAME_BUFFER_WHITE, FRAME_BUFFER_WHITE,
+  FRAME_BUFFER_INVERT, FRAME_BUFFER_INVERT,
+};
+
+void md_drawPixel(int16_t x, int16_t y, int8_t color) {
+  hostDrawCallCount++;
+  drawPixelToBuffer(buffer, x, y, colorTable[color]);
+}
+
+void md_drawRect(int16_t x, int16_t y, int16_t w, int16_t h, int8_t color) {
+  hostDrawCallCount++;
+  drawRectToBuffer(buffer, x, y, w, h, colorTable[color]);
+}
+
+static void drawBitmapByte(int16_t index, uint8_t v, uint8_t color) {
+  if (color == FRAME_BUFFER_WHITE) {
+    buffer[index] |= v;
+  } else if (color == FRAME_BUFFER_BLACK) {
+    buffer[index] &= ~v;
+  } else {
+    buffer[index] ^= v;
+  }
+}
+
+// Arduboy2Base::drawBitmap() as it is, so that the frame buffer is the same.
+static void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                       uint8_t w, uint8_t h, uint8_t color) {
+  if (x + w <= 0 || x > VIEW_SIZE_X - 1 || y + h <= 0 || y > VIEW_SIZE_Y - 1) {
+    return;
+  }
+  int yOffset = abs(y) % 8;
+  int sRow = y / 8;
+  if (y < 0) {
+    sRow--;
+    yOffset = 8 - yOffset;
+  }
+  int rows = h / 8;
+  if (h % 8 != 0) {
+    rows++;
+  }
+  for (int a = 0; a < rows; a++) {
+    int bRow = sRow + a;
+    if (bRow > (VIEW_SIZE_Y / 8) - 1) {
+      break;
+    }
+    if (bRow <= -2) {
+      continue;
+    }
+    for (int iCol = 0; iCol < w; iCol++) {
+      if (iCol + x > VIEW_SIZE_X - 1) {
+        break;
+      }
+      if (iCol + x < 0) {
+        continue;
+      }
+      uint8_t v = pgm_read_byte(bitmap + (a * w) + iCol);
+      if (bRow >= 0) {
+        drawBitmapByte((bRow * VIEW_SIZE_X) + x + iCol,
+                       (uint8_t)(v << yOffset), color);
+      }
+      if (yOffset && bRow < (VIEW_SIZE_Y / 8) - 1) {
+        drawBitmapByte(((bRow + 1) * VIEW_SIZE_X) + x + iCol,
+                       (uint8_t)(v >> (8 - yOffset)), color);
+      }
+    }
+  }
+}
+
+void md_drawCharacter(const uint8_t grid[CHARACTER_WIDTH], int16_t x, int16_t y,
+                      int8_t color) {
+  hostDrawCallCount++;
+  drawBitmap(x, y, grid, CHARACTER_WIDTH, CHARACTER_HEIGHT, colorTable[color]);
+}
+
+uint8_t md_getInputState(void) {
+  return hostInput;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static uint8_t currentPhase = PHASE_IDLE;
+static int64_t phaseStartTime;
+
+void resetHostPhases(void) {
+  memset(hostPhaseNsec, 0, sizeof(hostPhaseNsec));
+  currentPhase = PHASE_IDLE;
+  phaseStartTime = getTime();
+}
+
+void md_markPhase(uint8_t phase) {
+  int64_t now = getTime();
+  hostPhaseNsec[currentPhase] += now - phaseStartTime;
+  currentPhase = phase;
+  phaseStartTime = now;
+  if (hostPhaseHook) {
+    hostPhaseHook(phase);
+  }
+}
+
+#ifdef CGLAB_TRACE
+// The time in 4 usec units as the Arduboy.
+uint16_t md_getTraceTime(void) {
+  return getTime() / 4000;
+}
+
+void md_dumpTrace(const TraceEvent *events, uint8_t first, uint16_t count) {
+  FILE *file = hostTraceFile ? hostTraceFile : stdout;
+  fprintf(file, "time,event,value\n");
+  for (uint16_t i = 0; i < count; i++) {
+    const TraceEvent *event = &events[(first + i) & (CGLAB_TRACE_SIZE - 1)];
+    fprintf(file, "%u,%u,%u\n", event->time, event->type, event->value);
+  }
+}
+#endif
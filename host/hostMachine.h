@@ -0,0 +1,40 @@
+// Machine dependent functions for the host, other than audio. The frame buffer
+// is the same 1 KB page-oriented buffer as the Arduboy, drawn with the same
+// code, and md_refresh() copies it to `hostScreen` as the display does.
+#ifndef HOST_MACHINE_H
+#define HOST_MACHINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "machineDependent.h"
+
+#define HOST_BUFFER_SIZE (VIEW_SIZE_X * VIEW_SIZE_Y / 8)
+
+// The input state which md_getInputState() returns.
+extern uint8_t hostInput;
+// The frame buffer shown by the last md_refresh().
+extern uint8_t hostScreen[HOST_BUFFER_SIZE];
+
+// Draw to `buffer` of HOST_BUFFER_SIZE bytes, for stepping more than one game
+// in turn with their contexts, or to the built-in one with NULL.
+void setHostFrameBuffer(uint8_t *buffer);
+
+// The number of calls of md_drawPixel(), md_drawRect() and md_drawCharacter().
+extern uint32_t hostDrawCallCount;
+
+// Wait for 1/60 second in md_nextFrame(), otherwise frames run at full speed.
+// md_isFrameOverrun() is true after a frame that took longer while pacing.
+void setHostFramePacing(bool isPacing);
+
+// Nanoseconds counted for each phase by md_markPhase() with CGLAB_PROFILE.
+extern int64_t hostPhaseNsec[PHASE_COUNT];
+void resetHostPhases(void);
+// Called by md_markPhase() at the start of each phase unless NULL.
+extern void (*hostPhaseHook)(uint8_t phase);
+
+// The file which md_dumpTrace() writes with CGLAB_TRACE, or stdout with NULL.
+extern FILE *hostTraceFile;
+
+#endif
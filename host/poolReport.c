@@ -0,0 +1,28 @@
+// Report the SRAM of the engine pools of a sketch, built with the
+// cglabConfig.h of the sketch (make pools). The structs of the pools are laid
+// out in the same bytes on the host as on the Arduboy.
+#include <Arduino.h>
+#include <stdio.h>
+
+#include "cglab.h"
+
+#define POOL_ITEM_SIZE(pool) (uint32_t)sizeof(((CglabEngine *)0)->pool[0])
+
+static uint32_t printPool(const char *name, uint32_t count, uint32_t itemSize) {
+  printf("  %-12s %4u x %2u = %5u bytes\n", name, count, itemSize,
+         count * itemSize);
+  return count * itemSize;
+}
+
+int main(void) {
+  uint32_t total = 0;
+  printf("%s:\n", POOL_GAME);
+  total += printPool("hitBoxes", MAX_HIT_BOX_COUNT, POOL_ITEM_SIZE(hitBoxes));
+  total += printPool("frameScratch", CGLAB_FRAME_SCRATCH_SIZE, 1);
+  total += printPool("particles", MAX_PARTICLE_COUNT,
+                     POOL_ITEM_SIZE(particlePool.particles));
+  total += printPool("scoreBoards", MAX_SCORE_BOARD_COUNT,
+                     POOL_ITEM_SIZE(scoreBoards));
+  printf("  %-12s %17u bytes\n", "total", total);
+  return 0;
+}
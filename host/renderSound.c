@@ -0,0 +1,57 @@
+// Play the BGM and every sound effect of a game's 'soundPattern.h' with the
+// host audio, at the frame timing of the game, and report the audio timing.
+//   renderSound [-o output.wav] [-s seconds]
+#define _GNU_SOURCE
+#include <Arduino.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "cglab.h"
+#include "hostAudio.h"
+#include "machineDependent.h"
+
+#include SOUND_PATTERN_H
+
+#define SOUND_EFFECT_INTERVAL 30 // frames
+
+int main(int argc, char *argv[]) {
+  const char *wavPath = "sound.wav";
+  int seconds = 10;
+  int opt;
+  while ((opt = getopt(argc, argv, "o:s:")) != -1) {
+    if (opt == 'o') {
+      wavPath = optarg;
+    } else if (opt == 's') {
+      seconds = atoi(optarg);
+    } else {
+      fprintf(stderr, "usage: %s [-o output.wav] [-s seconds]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (!openHostAudio(wavPath)) {
+    perror(wavPath);
+    return 1;
+  }
+  struct timespec frameTime;
+  clock_gettime(CLOCK_MONOTONIC, &frameTime);
+  for (int frame = 0; frame < seconds * FPS; frame++) {
+    if (frame == 0) {
+      md_playSound(soundPatterns[BGM], true);
+    }
+    if (frame % SOUND_EFFECT_INTERVAL == 0) {
+      uint8_t type = (frame / SOUND_EFFECT_INTERVAL) % SOUND_EFFECT_TYPE_COUNT;
+      md_playSound(soundPatterns[type], false);
+    }
+    frameTime.tv_nsec += 1000000000L / FPS;
+    if (frameTime.tv_nsec >= 1000000000L) {
+      frameTime.tv_nsec -= 1000000000L;
+      frameTime.tv_sec++;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &frameTime, NULL);
+  }
+  md_stopSound(true);
+  closeHostAudio();
+  printHostAudioReport(stdout);
+  return 0;
+}
@@ -0,0 +1,22 @@
+#include "scriptedInput.h"
+
+#include <Arduino.h>
+
+#include "machineDependent.h"
+
+uint8_t getScriptedInput(uint32_t frame) {
+  uint32_t h = (frame / 8 + 1) * 2654435761UL;
+  h ^= h >> 15;
+  uint8_t input = 0;
+  if (h & bit(0)) {
+    input |= INPUT_A;
+  }
+  if ((h & (bit(1) | bit(2))) == 0) {
+    input |= INPUT_B;
+  }
+  static const uint8_t directions[] = {
+    0, INPUT_LEFT, INPUT_RIGHT, INPUT_UP, INPUT_DOWN,
+    INPUT_LEFT | INPUT_UP, INPUT_RIGHT | INPUT_DOWN, 0,
+  };
+  return input | directions[(h >> 3) & 7];
+}
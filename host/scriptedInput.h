@@ -0,0 +1,12 @@
+// The scripted input to play the games deterministically, which is shared by
+// the host tools and the simulator runner.
+#ifndef SCRIPTED_INPUT_H
+#define SCRIPTED_INPUT_H
+
+#include <stdint.h>
+
+// The input state of `frame`, which changes every 8 frames and presses A and B
+// often enough to leave the title and game-over screens.
+uint8_t getScriptedInput(uint32_t frame);
+
+#endif
@@ -0,0 +1,73 @@
+#!/usr/bin/python3
+# Convert the CSV of dumpTrace() to the Trace Event Format JSON, which
+# chrome://tracing and https://ui.perfetto.dev show as a timeline.
+#   python3 traceTimeline.py [trace.csv] > trace.json
+# The frames are the spans from the begin to the end events, and the other
+# events are instants in them. The values are the low 12 bits, and the frame
+# numbers are unwrapped while the frames follow each other.
+import csv
+import json
+import sys
+
+TIME_USEC = 4
+TIME_WRAP = 0x10000
+VALUE_WRAP = 0x1000
+
+EVENT_NAMES = [
+	'frame', 'frame end', 'state', 'play', 'addScore', 'gameOver',
+	'hit box overflow',
+]
+STATE_NAMES = ['title', 'in game', 'game over']
+SOUND_NAMES = [
+	'COIN', 'LASER', 'EXPLOSION', 'POWER_UP', 'HIT', 'JUMP', 'SELECT',
+	'RANDOM', 'CLICK',
+]
+
+def readEvents(file):
+	lastTime = None
+	usec = 0
+	for row in csv.DictReader(file):
+		time = int(row['time'])
+		if lastTime is not None:
+			usec += (time - lastTime) % TIME_WRAP * TIME_USEC
+		lastTime = time
+		yield usec, int(row['event']), int(row['value'])
+
+def convert(file):
+	events = []
+	frame = None
+	lastTicks = None
+	for usec, event, value in readEvents(file):
+		if event == 0:
+			ticks = value
+			if lastTicks is not None and value == (lastTicks + 1) % VALUE_WRAP:
+				ticks = lastTicks + 1
+			lastTicks = ticks
+			frame = (usec, ticks)
+		elif event == 1:
+			if frame:
+				events.append({
+					'name': 'frame %d' % frame[1], 'ph': 'X', 'ts': frame[0],
+					'dur': usec - frame[0], 'pid': 0, 'tid': 0,
+					'args': {'draw calls': value},
+				})
+			frame = None
+		else:
+			name = EVENT_NAMES[event] if event < len(EVENT_NAMES) else str(event)
+			if event == 2 and value < len(STATE_NAMES):
+				value = STATE_NAMES[value]
+			elif event == 3 and value < len(SOUND_NAMES):
+				value = SOUND_NAMES[value]
+			events.append({
+				'name': name, 'ph': 'i', 's': 't', 'ts': usec, 'pid': 0,
+				'tid': 0, 'args': {'value': value},
+			})
+	return {'traceEvents': events, 'displayTimeUnit': 'ms'}
+
+def main():
+	file = open(sys.argv[1], newline='') if len(sys.argv) > 1 else sys.stdin
+	json.dump(convert(file), sys.stdout, indent=1)
+	sys.stdout.write('\n')
+
+if __name__ == '__main__':
+	main()
@@ -2,60 +2,90 @@
 #include "cglab.h"
 #include "machineDependent.h"
 #include "particle.h"
+#include "random.h"
 #include "textPattern.h"
 #include "vector.h"
-
-enum STATE_ENUM {
-  STATE_TITLE = 0,
-  STATE_IN_GAME,
-  STATE_GAME_OVER,
-};
 /// \endcond
 
 //! A variable incremented by one every 1/60 of a second (readonly).
 uint16_t ticks;
 //! Game score.
-float score;
+Number score;
 //! A variable that is one at the beginning of the game, two after 1 minute, and
 //! increasing by one every minute (readonly).
-float difficulty;
+Number difficulty;
 //! Set the color for drawing rectangles, particles, texts, and characters.
 //! Setting the color prior to `text()` and `character()` will recolor the
 //! pixel art. Use `color = LIGHT1` to restore and use the original colors.
 //! Colors are `DARK*`, `LIGHT*`, `INVERT*` and `TRANSPARENT`.
 int8_t color;
 //! Set the thickness for drawing `line()`, `bar()` and `arc()`.
-float thickness;
+Number thickness;
 //! A value from 0 to 1 that defines where the center coordinates are on the
 //! `bar()`, default: 0.5.
-float barCenterPosRatio;
+Number barCenterPosRatio;
 //! If `hasCollision` is set to `true`, the drawn rectangle will have no
 //! collision with other rectangles. Used to improve performance.
 bool hasCollision;
-
-static uint8_t state;
-
-static const char *title;
-static const char *description;
-static const CharacterData *characters;
-static const uint8_t **sounds;
-static void (*update)(void);
+#ifdef CGLAB_FRAME_SKIP
+//! Number of the frames in game whose drawing was skipped because the
+//! previous frame overran (readonly).
+uint16_t skippedFrameCount;
+#endif
+#ifdef CGLAB_STATS
+//! Counts of the hit boxes, the collision tests, the draw calls, the
+//! overwritten particles and score boards, the bytes of the frame arena used
+//! and the failed `frameAlloc()` calls in the last frame, and the maximum of
+//! each (readonly).
+EngineStats engineStats;
+#endif
+#ifdef CGLAB_MEMORY_PROBE
+//! Bytes of the stack used in the last frame, the maximum of them in each
+//! state (the title, in game and the game over) and the least free RAM seen
+//! between the heap and the stack (readonly). They are of the machine and are
+//! not in `CglabContext`.
+MemoryStats memoryStats;
+#endif
+#ifdef CGLAB_TRACE
+//! The last `CGLAB_TRACE_SIZE` (default: 64) events of the frames since
+//! `initGame()`, written by `dumpTrace()` (readonly).
+EngineTrace engineTrace;
+#endif
+
+// The engine state of the game in use. There is only one game in use at a
+// time, so the library is not reentrant, and switching the games copies the
+// whole state out and in (see saveContext()).
+static CglabEngine cglab;
+
+// Trace
+#ifdef CGLAB_TRACE
+static void traceEvent(uint8_t type, uint16_t value) {
+  TraceEvent *event = &engineTrace.events[engineTrace.index];
+  event->time = md_getTraceTime();
+  event->type = type;
+  event->value = value & 0xFFF;
+  engineTrace.index = (engineTrace.index + 1) & (CGLAB_TRACE_SIZE - 1);
+  if (engineTrace.index == 0) {
+    engineTrace.isWrapped = true;
+  }
+}
+#define TRACE(type, value) traceEvent(type, value)
+
+//! Write the events of the trace, the oldest first, as CSV lines of the time
+//! in 4 usec units (wrapping around at 65536), the event type and the value.
+//! The Arduboy writes them to `Serial` while a serial monitor is open.
+void dumpTrace(void) {
+  if (engineTrace.isWrapped) {
+    md_dumpTrace(engineTrace.events, engineTrace.index, CGLAB_TRACE_SIZE);
+  } else {
+    md_dumpTrace(engineTrace.events, 0, engineTrace.index);
+  }
+}
+#else
+#define TRACE(type, value)
+#endif
 
 // Collision
-/// \cond
-typedef struct {
-  uint8_t index;
-  int8_t  x;
-  int8_t  y;
-  uint8_t w;
-  uint8_t h;
-} HitBox;
-
-#define MAX_HIT_BOX_COUNT 120
-/// \endcond
-static HitBox hitBoxes[MAX_HIT_BOX_COUNT];
-static uint8_t hitBoxesIndex;
-
 static void initCollision(Collision *collision) {
   memset(collision, 0, sizeof(Collision));
 }
@@ -67,20 +97,63 @@ static bool testCollision(HitBox r1, HitBox r2) {
 }
 
 static void checkHitBox(Collision *cl, HitBox hitBox) {
-  for (uint8_t i = 0; i < hitBoxesIndex; i++) {
-    HitBox hb = hitBoxes[i];
+  HOOK_HIT_BOX_TESTS(cglab.hitBoxesIndex);
+  ADD_STAT(hitBoxTestCount, cglab.hitBoxesIndex);
+  for (uint8_t i = 0; i < cglab.hitBoxesIndex; i++) {
+    HitBox hb = cglab.hitBoxes[i];
     if (testCollision(hb, hitBox)) {
       bitSet(cl->isColliding[(hb.index >> 4)], hb.index & 0xF);
     }
   }
 }
 
+// Frame arena
+// Whether the hit box of `index` fits under the blocks of frameAlloc(). The
+// hit boxes are at most MAX_HIT_BOX_COUNT so that the blocks have at least
+// CGLAB_FRAME_SCRATCH_SIZE bytes.
+static bool canAddHitBox(uint8_t index) {
+  return index < MAX_HIT_BOX_COUNT &&
+         (index + 1) * sizeof(HitBox) <=
+             FRAME_ARENA_SIZE - cglab.frameScratchSize;
+}
+
+//! Allocate `size` bytes for the frame, which are freed at the start of the
+//! next frame, e.g. for a text to draw. The blocks and the hit boxes of the
+//! frame share the frame arena of `MAX_HIT_BOX_COUNT` hit boxes and
+//! `CGLAB_FRAME_SCRATCH_SIZE` (default: 16) bytes. Blocks over that take the
+//! space of the hit boxes that the frame doesn't store, and the hit boxes
+//! stop at them. The blocks are byte aligned, for texts and bytes. Returns
+//! NULL when the arena is full.
+void *frameAlloc(uint16_t size) {
+  uint16_t top = FRAME_ARENA_SIZE - cglab.frameScratchSize;
+  uint16_t bottom = cglab.hitBoxesIndex * sizeof(HitBox);
+  if (size > top - bottom) {
+    ADD_STAT(failedFrameAllocCount, 1);
+    return NULL;
+  }
+  cglab.frameScratchSize += size;
+  return &cglab.frameArena[top - size];
+}
+
+// Too many hit boxes to store in the frame. Only the first one is traced.
+static void dropHitBox(void) {
+  ADD_STAT(droppedHitBoxCount, 1);
+#ifdef CGLAB_TRACE
+  if (!engineTrace.hasHitBoxOverflow) {
+    engineTrace.hasHitBoxOverflow = true;
+    TRACE(TRACE_HIT_BOX_OVERFLOW, 0);
+  }
+#endif
+}
+
 /// \cond
 #define VALID_HIT_LENGTH 64
 /// \endcond
-static bool isValidHitCoord(float x, float y) {
-  return x >= -VALID_HIT_LENGTH && x < VIEW_SIZE_X + VALID_HIT_LENGTH &&
-         y >= -VALID_HIT_LENGTH && y < VIEW_SIZE_Y + VALID_HIT_LENGTH;
+static bool isValidHitCoord(Number x, Number y) {
+  return x >= NUM(-VALID_HIT_LENGTH) &&
+         x < NUM(VIEW_SIZE_X + VALID_HIT_LENGTH) &&
+         y >= NUM(-VALID_HIT_LENGTH) &&
+         y < NUM(VIEW_SIZE_Y + VALID_HIT_LENGTH);
 }
 
 static bool isCollidingSomething(Collision *cl, uint8_t index) {
@@ -115,11 +188,24 @@ bool colCharacter(Collision *cl, char character) {
 }
 
 // Drawing
-static uint8_t drawingHitBoxesIndex;
+//! Enable drawing to the screen (default).
+void enableRendering(void) {
+  cglab.isRenderingDisabled = false;
+}
 
-static void beginAddingRects(void) { drawingHitBoxesIndex = hitBoxesIndex; }
+//! Disable drawing to the screen to run the game as fast as possible, for
+//! bots, replays and simulations. The drawing functions still check the
+//! collisions, so the game goes on the same as with drawing.
+void disableRendering(void) {
+  cglab.isRenderingDisabled = true;
+  cglab.isRendering = false;
+}
 
-static void addRect(bool isAlignCenter, float x, float y, float w, float h,
+static void beginAddingRects(void) {
+  cglab.drawingHitBoxesIndex = cglab.hitBoxesIndex;
+}
+
+static void addRect(bool isAlignCenter, Number x, Number y, Number w, Number h,
                     Collision *hitCollision) {
   if (isAlignCenter) {
     x -= w / 2;
@@ -128,62 +214,73 @@ static void addRect(bool isAlignCenter, float x, float y, float w, float h,
   if (hasCollision && isValidHitCoord(x, y)) {
     HitBox hb;
     hb.index = HIT_BOX_INDEX_COLOR_BASE + color;
-    hb.x = x;
-    hb.y = y;
-    hb.w = w;
-    hb.h = h;
+    hb.x = NUM_INT(x);
+    hb.y = NUM_INT(y);
+    hb.w = NUM_INT(w);
+    hb.h = NUM_INT(h);
     checkHitBox(hitCollision, hb);
-    if (color > TRANSPARENT && drawingHitBoxesIndex < MAX_HIT_BOX_COUNT) {
-      hitBoxes[drawingHitBoxesIndex] = hb;
-      drawingHitBoxesIndex++;
+    if (color > TRANSPARENT) {
+      if (canAddHitBox(cglab.drawingHitBoxesIndex)) {
+        cglab.hitBoxes[cglab.drawingHitBoxesIndex] = hb;
+        cglab.drawingHitBoxesIndex++;
+      } else {
+        dropHitBox();
+      }
     }
   }
-  if (color > TRANSPARENT && color < COLOR_COUNT) {
-    md_drawRect(x, y, w, h, color);
+  if (cglab.isRendering && color > TRANSPARENT && color < COLOR_COUNT) {
+    md_drawRect(NUM_INT(x), NUM_INT(y), NUM_INT(w), NUM_INT(h), color);
+    ADD_STAT(rectDrawCount, 1);
   }
 }
 
 static void addHitBox(HitBox hb) {
-  if (hitBoxesIndex < MAX_HIT_BOX_COUNT) {
-    hitBoxes[hitBoxesIndex] = hb;
-    hitBoxesIndex++;
+  if (canAddHitBox(cglab.hitBoxesIndex)) {
+    cglab.hitBoxes[cglab.hitBoxesIndex] = hb;
+    cglab.hitBoxesIndex++;
   } else {
-    // Too many hit boxes!
+    dropHitBox();
   }
 }
 
 static void endAddingRects(void) {
-  hitBoxesIndex = drawingHitBoxesIndex;
+  cglab.hitBoxesIndex = cglab.drawingHitBoxesIndex;
 }
 
 //! Draw a rectangle. Returns information on objects that collided while drawing.
-Collision rect(float x, float y, float w, float h) {
+Collision rect(Number x, Number y, Number w, Number h) {
   Collision hitCollision;
   initCollision(&hitCollision);
   beginAddingRects();
   addRect(false, x, y, w, h, &hitCollision);
   endAddingRects();
+  HOOK_COLLISION(&hitCollision);
   return hitCollision;
 }
 
 //! Draw a box. Returns information on objects that collided while drawing.
-Collision box(float x, float y, float w, float h) {
+Collision box(Number x, Number y, Number w, Number h) {
   Collision hitCollision;
   initCollision(&hitCollision);
   beginAddingRects();
   addRect(true, x, y, w, h, &hitCollision);
   endAddingRects();
+  HOOK_COLLISION(&hitCollision);
   return hitCollision;
 }
 
-static void drawLine(float x, float y, float ox, float oy,
+static void drawLine(Number x, Number y, Number ox, Number oy,
                      Collision *hitCollision) {
-  float lx = fabsf(ox);
-  float ly = fabsf(oy);
-  float t = thickness * 1.5f;
-  t = clamp(t, 3, 10);
-  uint8_t rn = ceilf(lx > ly ? lx / t : ly / t);
-  rn = clamp(rn, 3, 49);
+  Number lx = numAbs(ox);
+  Number ly = numAbs(oy);
+  Number t = NUM_MUL(thickness, NUM(1.5f));
+  t = clamp(t, NUM(3), NUM(10));
+  uint8_t rn = NUM_CEIL(NUM_DIV(lx > ly ? lx : ly, t));
+  if (rn < 3) {
+    rn = 3;
+  } else if (rn > 49) {
+    rn = 49;
+  }
   ox /= (rn - 1);
   oy /= (rn - 1);
   for (uint8_t i = 0; i < rn; i++) {
@@ -194,36 +291,39 @@ static void drawLine(float x, float y, float ox, float oy,
 }
 
 //! Draw a line. Returns information on objects that collided while drawing.
-Collision line(float x1, float y1, float x2, float y2) {
+Collision line(Number x1, Number y1, Number x2, Number y2) {
   Collision hitCollision;
   initCollision(&hitCollision);
   beginAddingRects();
   drawLine(x1, y1, x2 - x1, y2 - y1, &hitCollision);
   endAddingRects();
+  HOOK_COLLISION(&hitCollision);
   return hitCollision;
 }
 
 //! Draw a bar. Returns information on objects that collided while drawing.
-Collision bar(float x, float y, float length, float angle) {
+Collision bar(Number x, Number y, Number length, Number angle) {
   Collision hitCollision;
   initCollision(&hitCollision);
   Vector l;
   rotate(vectorSet(&l, length, 0), angle);
   Vector p;
-  vectorSet(&p, x - l.x * barCenterPosRatio, y - l.y * barCenterPosRatio);
+  vectorSet(&p, x - NUM_MUL(l.x, barCenterPosRatio),
+            y - NUM_MUL(l.y, barCenterPosRatio));
   beginAddingRects();
   drawLine(p.x, p.y, l.x, l.y, &hitCollision);
   endAddingRects();
+  HOOK_COLLISION(&hitCollision);
   return hitCollision;
 }
 
 //! Draw a arc. Returns information on objects that collided while drawing.
-Collision arc(float centerX, float centerY, float radius, float angleFrom,
-              float angleTo) {
+Collision arc(Number centerX, Number centerY, Number radius, Number angleFrom,
+              Number angleTo) {
   Collision hitCollision;
   initCollision(&hitCollision);
   beginAddingRects();
-  float af, ao;
+  Number af, ao;
   if (angleFrom > angleTo) {
     af = angleTo;
     ao = angleFrom - angleTo;
@@ -231,26 +331,31 @@ Collision arc(float centerX, float centerY, float radius, float angleFrom,
     af = angleFrom;
     ao = angleTo - angleFrom;
   }
-  if (ao < 0.01f) {
+  if (ao < NUM(0.01f)) {
+    HOOK_COLLISION(&hitCollision);
     return hitCollision;
   }
   if (ao < 0) {
     ao = 0;
-  } else if (ao > M_PI * 2) {
-    ao = M_PI * 2;
-  }
-  uint8_t lc = ceilf(ao * sqrtf(radius * 0.125f));
-  lc = clamp(lc, 1, 18);
-  float ai = ao / lc;
-  float a = af;
-  float p1x = radius * cosf(a) + centerX;
-  float p1y = radius * sinf(a) + centerY;
-  float p2x, p2y;
-  float ox, oy;
+  } else if (ao > NUM(M_PI * 2)) {
+    ao = NUM(M_PI * 2);
+  }
+  uint8_t lc = NUM_CEIL(NUM_MUL(ao, numSqrt(NUM_MUL(radius, NUM(0.125f)))));
+  if (lc < 1) {
+    lc = 1;
+  } else if (lc > 18) {
+    lc = 18;
+  }
+  Number ai = ao / lc;
+  Number a = af;
+  Number p1x = NUM_MUL(radius, numCos(a)) + centerX;
+  Number p1y = NUM_MUL(radius, numSin(a)) + centerY;
+  Number p2x, p2y;
+  Number ox, oy;
   for (uint8_t i = 0; i < lc; i++) {
     a += ai;
-    p2x = radius * cosf(a) + centerX;
-    p2y = radius * sinf(a) + centerY;
+    p2x = NUM_MUL(radius, numCos(a)) + centerX;
+    p2y = NUM_MUL(radius, numSin(a)) + centerY;
     ox = p2x - p1x;
     oy = p2y - p1y;
     drawLine(p1x, p1y, ox, oy, &hitCollision);
@@ -258,37 +363,42 @@ Collision arc(float centerX, float centerY, float radius, float angleFrom,
     p1y = p2y;
   }
   endAddingRects();
+  HOOK_COLLISION(&hitCollision);
   return hitCollision;
 }
 
 // Text and character
-static void drawCharacter(uint8_t index, float x, float y, bool _hasCollision,
-                          bool isText, Collision *hitCollision) {
+static void drawCharacter(uint8_t index, Number x, Number y,
+                          bool _hasCollision, bool isText,
+                          Collision *hitCollision) {
   if ((isText && (index < '!' || index > '~')) ||
       (!isText && (index < 'a' || index > 'z'))) {
     return;
   }
-  if (color > TRANSPARENT && color < COLOR_COUNT &&
-      x > -CHARACTER_WIDTH && x < VIEW_SIZE_X &&
-      y > -CHARACTER_HEIGHT && y < VIEW_SIZE_Y) {
+  if (cglab.isRendering && color > TRANSPARENT && color < COLOR_COUNT &&
+      x > NUM(-CHARACTER_WIDTH) && x < NUM(VIEW_SIZE_X) &&
+      y > NUM(-CHARACTER_HEIGHT) && y < NUM(VIEW_SIZE_Y)) {
     const uint8_t *grid =
-        isText ? textPatterns[index - '!'] : characters[index - 'a'].grid;
-    md_drawCharacter(grid, x, y, color);
+        isText ? textPatterns[index - '!']
+               : cglab.characters[index - 'a'].grid;
+    md_drawCharacter(grid, NUM_INT(x), NUM_INT(y), color);
+    ADD_STAT(characterDrawCount, 1);
   }
   if (hasCollision && _hasCollision && isValidHitCoord(x, y)) {
     HitBox hb;
     if (isText) {
       hb.index = HIT_BOX_INDEX_TEXT_BASE + (index - '!');
-      hb.x = x + 1;
-      hb.y = y + 1;
+      hb.x = NUM_INT(x + NUM(1));
+      hb.y = NUM_INT(y + NUM(1));
       hb.w = CHARACTER_WIDTH - 1;
       hb.h = CHARACTER_HEIGHT - 1;
     } else {
       hb.index = HIT_BOX_INDEX_CHARACTER_BASE + (index - 'a');
       CharacterHitBox chb;
-      *((uint16_t *)&chb) = pgm_read_word(&characters[index - 'a'].hitBox); 
-      hb.x = x + chb.x;
-      hb.y = y + chb.y;
+      *((uint16_t *)&chb) =
+          pgm_read_word(&cglab.characters[index - 'a'].hitBox);
+      hb.x = NUM_INT(x + NUM(chb.x));
+      hb.y = NUM_INT(y + NUM(chb.y));
       hb.w = chb.w;
       hb.h = chb.h;
     }
@@ -299,84 +409,157 @@ static void drawCharacter(uint8_t index, float x, float y, bool _hasCollision,
   }
 }
 
-static Collision drawConstCharacters(const char *msg, float x, float y,
+static Collision drawConstCharacters(const char *msg, Number x, Number y,
                                      bool _hasCollision, bool isText) {
   Collision hitCollision;
   initCollision(&hitCollision);
   uint8_t ml = strlen_P(msg);
-  x -= CHARACTER_WIDTH / 2;
-  y -= CHARACTER_HEIGHT / 2;
+  x -= NUM(CHARACTER_WIDTH / 2);
+  y -= NUM(CHARACTER_HEIGHT / 2);
   for (uint8_t i = 0; i < ml; i++) {
     drawCharacter(pgm_read_byte(&msg[i]), x, y, _hasCollision, isText,
                   &hitCollision);
-    x += CHARACTER_WIDTH;
+    x += NUM(CHARACTER_WIDTH);
   }
   return hitCollision;
 }
 
-static Collision drawCharacters(char *msg, float x, float y, bool _hasCollision,
-                                bool isText) {
+static Collision drawCharacters(char *msg, Number x, Number y,
+                                bool _hasCollision, bool isText) {
   Collision hitCollision;
   initCollision(&hitCollision);
   uint8_t ml = strlen(msg);
-  x -= CHARACTER_WIDTH / 2;
-  y -= CHARACTER_HEIGHT / 2;
+  x -= NUM(CHARACTER_WIDTH / 2);
+  y -= NUM(CHARACTER_HEIGHT / 2);
   for (uint8_t i = 0; i < ml; i++) {
     drawCharacter(msg[i], x, y, _hasCollision, isText, &hitCollision);
-    x += CHARACTER_WIDTH;
+    x += NUM(CHARACTER_WIDTH);
   }
   return hitCollision;
 }
 
 //! Draw a text. Returns information on objects that collided while drawing.
-Collision text(char *msg, float x, float y) {
-  return drawCharacters(msg, x, y, true, true);
+Collision text(char *msg, Number x, Number y) {
+  Collision hitCollision = drawCharacters(msg, x, y, true, true);
+  HOOK_COLLISION(&hitCollision);
+  return hitCollision;
 }
 
 //! Draw a const text. Returns information on objects that collided while drawing.
-Collision constText(const char *msg, float x, float y) {
-  return drawConstCharacters(msg, x, y, true, true);
+Collision constText(const char *msg, Number x, Number y) {
+  Collision hitCollision = drawConstCharacters(msg, x, y, true, true);
+  HOOK_COLLISION(&hitCollision);
+  return hitCollision;
 }
 
 //! Draw a pixel art. Returns information on objects that collided while
 //! drawing. You can define pixel arts (6x6 dots) of characters with
 //! `characters` array.
-Collision character(char character, float x, float y) {
+Collision character(char character, Number x, Number y) {
   Collision hitCollision;
   initCollision(&hitCollision);
-  x -= CHARACTER_WIDTH / 2;
-  y -= CHARACTER_HEIGHT / 2;
+  x -= NUM(CHARACTER_WIDTH / 2);
+  y -= NUM(CHARACTER_HEIGHT / 2);
   drawCharacter(character, x, y, true, false, &hitCollision);
+  HOOK_COLLISION(&hitCollision);
   return hitCollision;
 }
 
 // Color
 static void clearView(void) {
-  md_clearView();
+  if (cglab.isRendering) {
+    md_clearView();
+  }
 }
 
-static uint8_t savedColor;
-
 static void resetColor(void) {
   color = DEFAULT_COLOR;
 }
 
 static void saveCurrentColor(void) {
-  savedColor = color;
+  cglab.savedColor = color;
   resetColor();
 }
 
 static void loadCurrentColor(void) {
-  color = savedColor;
+  color = cglab.savedColor;
 }
 
 // Sound
-static uint8_t soundType;
+/// \cond
+#define SOUND_REQUEST_FRAMES 16
+/// \endcond
+
+//! Frames from `play()` to the frame where the sound effect is passed to
+//! `md_playSound()` (readonly). The sequencer starts the tone timer of the
+//! first note within that call, so this is the delay to the tone unless the
+//! pattern starts with a rest. `droppedCount` counts the requests that waited
+//! too long behind a sound effect with higher priority.
+SoundStartDelay soundStartDelay;
+
+PROGMEM static const uint8_t soundPriorities[SOUND_EFFECT_TYPE_COUNT] = {
+  3, 2, 6, 4, 4, 2, 1, 5, 0,
+};
+
+static void playSoundPattern(uint8_t type);
+
+static void initSound(void) {
+  cglab.requestedSounds = 0;
+  cglab.playingSoundType = -1;
+}
+
+static uint8_t getSoundPriority(uint8_t type) {
+  return pgm_read_byte(&soundPriorities[type]);
+}
+
+static void startRequestedSound(void) {
+  int8_t type = -1;
+  for (uint8_t i = 0; i < SOUND_EFFECT_TYPE_COUNT; i++) {
+    if (!bitRead(cglab.requestedSounds, i)) {
+      continue;
+    }
+    if ((uint8_t)(cglab.soundFrameCount - cglab.requestedFrames[i]) >=
+        SOUND_REQUEST_FRAMES) {
+      bitClear(cglab.requestedSounds, i);
+      soundStartDelay.droppedCount++;
+    } else if (type < 0 || getSoundPriority(i) >= getSoundPriority(type)) {
+      type = i;
+    }
+  }
+  if (type < 0) {
+    return;
+  }
+  // Don't cut a sound effect which has higher priority.
+  if (cglab.playingSoundType >= 0 && md_isSoundPlaying(false) &&
+      getSoundPriority(cglab.playingSoundType) > getSoundPriority(type)) {
+    return;
+  }
+  playSoundPattern(type);
+  bitClear(cglab.requestedSounds, type);
+  cglab.playingSoundType = type;
+  uint8_t delay = cglab.soundFrameCount - cglab.requestedFrames[type];
+  soundStartDelay.lastFrames = delay;
+  if (delay > soundStartDelay.maxFrames) {
+    soundStartDelay.maxFrames = delay;
+  }
+  soundStartDelay.totalFrames += delay;
+  soundStartDelay.startedCount++;
+}
 
 //! Play a sound effect. Type are `COIN`, `LASER`, `EXPLOSION`, `POWER_UP`,
-//! `HIT`, `JUMP`, `SELECT`, `CLICK` and `RANDOM`.
+//! `HIT`, `JUMP`, `SELECT`, `CLICK` and `RANDOM`. The sound effect starts
+//! immediately unless one with higher priority (e.g. `EXPLOSION` over `CLICK`)
+//! is playing, in which case it waits for a few frames.
 void play(uint8_t type) {
-  soundType = type;
+  if (type >= SOUND_EFFECT_TYPE_COUNT) {
+    return;
+  }
+  TRACE(TRACE_PLAY, type);
+  cglab.requestedFrames[type] = cglab.soundFrameCount;
+  bitSet(cglab.requestedSounds, type);
+#ifndef CGLAB_SOUND_QUANTIZED
+  startRequestedSound();
+#endif
 }
 
 //! Enable playing background music and sound effects.
@@ -395,79 +578,82 @@ void toggleSound(void) {
 }
 
 PROGMEM static const uint8_t defaultSe[] = {
-  0x90, 0x48, 0x00, 0x10, 0x90, 0x4B, 0x00, 0x11, 0x90,
-  0x4E, 0x00, 0x11, 0x90, 0x51, 0x00, 0x10, 0x80, 0xF0,
+  0x01, 0x80, 0x48, 0xC3, 0xC3, 0xC3, 0x00,
 };
 PROGMEM static const uint8_t defaultBgm[] = {
-  0x90, 0x3C, 0x00, 0x85, 0x80, 0x00, 0x85, 0x90, 0x3E, 0x00, 0x86, 0x80,
-  0x00, 0x85, 0x90, 0x40, 0x00, 0x85, 0x80, 0x01, 0x90, 0x90, 0x41, 0x00,
-  0x86, 0x80, 0x00, 0x85, 0x90, 0x40, 0x00, 0x85, 0x80, 0x00, 0x85, 0x90,
-  0x3E, 0x00, 0x86, 0x80, 0x01, 0x90, 0x90, 0x39, 0x00, 0x85, 0x80, 0x00,
-  0x85, 0x90, 0x3B, 0x00, 0x86, 0x80, 0x00, 0x85, 0x90, 0x3C, 0x00, 0x85,
-  0x80, 0x01, 0x90, 0x90, 0x3E, 0x00, 0x86, 0x80, 0x00, 0x85, 0x90, 0x3C,
-  0x00, 0x85, 0x80, 0x00, 0x85, 0x90, 0x3B, 0x00, 0x86, 0x80, 0x01, 0x90, 0xE0,
+  0x08, 0x80, 0x3C, 0x48, 0xC2, 0x48, 0xC2, 0x58, 0xC1, 0x48, 0xBF, 0x48,
+  0xBE, 0x58, 0xBB, 0x48, 0xC2, 0x48, 0xC1, 0x58, 0xC2, 0x48, 0xBE, 0x48,
+  0xBF, 0x58, 0x40,
 };
 
+static void playSoundPattern(uint8_t type) {
+  bool isBgm = type == BGM;
+  const uint8_t *p;
+  if (cglab.sounds) {
+    p = (const uint8_t *)pgm_read_ptr(&cglab.sounds[type]);
+  } else {
+    p = isBgm ? defaultBgm : defaultSe;
+  }
+  md_playSound(p, isBgm);
+}
+
 static void updateSound(void) {
+#ifdef CGLAB_SOUND_QUANTIZED
   if ((ticks & 0x0F) == 0) {
-    if (soundType >= 0 && soundType < SOUND_EFFECT_TYPE_COUNT) {
-      const uint8_t *p = sounds ? pgm_read_ptr(&sounds[soundType]) : defaultSe;
-      md_playSound(p, false);
-    }
-    soundType = -1;
-  }
-  if ((ticks & 0xFF) == 0) {
-    if (state == STATE_IN_GAME) {
-      const uint8_t *p = sounds ? pgm_read_ptr(&sounds[BGM]) : defaultBgm;
-      md_playSound(p, true);
-    } else {
-      md_stopSound(true);
-    }
+    startRequestedSound();
   }
+#else
+  startRequestedSound();
+#endif
+  cglab.soundFrameCount++;
 }
 
 // Score
-static uint16_t hiScore;
-
 /// \cond
-typedef struct {
-  uint32_t value:14;
-  uint32_t x:7;
-  uint32_t y:6;
-  uint32_t ticks:5;
-} ScoreBoard;
-
-#define MAX_SCORE_BOARD_COUNT 4
 #define SCORE_VALUE_OFFSET 5000
 /// \endcond
-static ScoreBoard scoreBoards[MAX_SCORE_BOARD_COUNT];
-static uint8_t scoreBoardsIndex;
 
-static void initScore(void) { score = hiScore = 0; }
+static void initScore(void) { score = cglab.hiScore = 0; }
 
 static void initScoreBoards(void) {
   for (uint8_t i = 0; i < MAX_SCORE_BOARD_COUNT; i++) {
-    scoreBoards[i].ticks = 0;
+    cglab.scoreBoards[i].ticks = 0;
+  }
+  cglab.scoreBoardsIndex = 0;
+}
+
+// The texts of the engine are in the frame arena, or on the stack when the
+// game has taken the rest of it. They are drawn after update(), so their
+// blocks never take the place of a hit box of the game.
+static void drawScoreBoard(ScoreBoard *sb, char *sc) {
+  int16_t value = sb->value - SCORE_VALUE_OFFSET;
+  bool isPositive = value >= 0;
+  uint8_t ll = sprintf(sc + isPositive, "%d", value);
+  if (isPositive) {
+    sc[0] = '+';
+    ll++;
   }
-  scoreBoardsIndex = 0;
+  Number x = NUM(sb->x - (ll - 1) * CHARACTER_WIDTH / 2);
+  Number y = NUM(sb->y) + NUM(sb->ticks * sb->ticks) / 45;
+  drawCharacters(sc, x, y, false, true);
 }
 
 static void updateScoreBoards(void) {
   saveCurrentColor();
+  char fallback[6];
+  char *sc = NULL;
   for (uint8_t i = 0; i < MAX_SCORE_BOARD_COUNT; i++) {
-    ScoreBoard *sb = &scoreBoards[i];
+    ScoreBoard *sb = &cglab.scoreBoards[i];
     if (sb->ticks > 0) {
-      char sc[6];
-      int16_t value = sb->value - SCORE_VALUE_OFFSET;
-      bool isPositive = value >= 0;
-      uint8_t ll = sprintf(sc + isPositive, "%d", value);
-      if (isPositive) {
-        sc[0] = '+';
-        ll++;
+      if (cglab.isRendering) {
+        if (!sc) {
+          sc = frameAlloc(sizeof(fallback));
+          if (!sc) {
+            sc = fallback;
+          }
+        }
+        drawScoreBoard(sb, sc);
       }
-      float x = sb->x - (ll - 1) * CHARACTER_WIDTH / 2;
-      float y = sb->y + sb->ticks * sb->ticks / 45.0f;
-      drawCharacters(sc, x, y, false, true);
       sb->ticks--;
     }
   }
@@ -476,89 +662,169 @@ static void updateScoreBoards(void) {
 
 //! Add score points and draw additional score on the screen. You can also add
 //! score points simply by adding the `score` variable.
-void addScore(float value, float x, float y) {
+void addScore(Number value, Number x, Number y) {
+  TRACE(TRACE_ADD_SCORE, value > 0 ? NUM_INT(value) : 0);
   if (value < 0 && score < -value) {
     score = 0;
   } else {
     score += value;
   }
-  if (value >= 10000 || value < -SCORE_VALUE_OFFSET) {
+  if (value >= NUM(10000) || value < NUM(-SCORE_VALUE_OFFSET)) {
     return;
   }
-  ScoreBoard *sb = &scoreBoards[scoreBoardsIndex];
-  sb->x = clamp(x, 0, VIEW_SIZE_X - 1);
-  y -= 20;
-  sb->y = clamp(y, 0, VIEW_SIZE_Y - 1);
-  sb->value = value + SCORE_VALUE_OFFSET;
+  ScoreBoard *sb = &cglab.scoreBoards[cglab.scoreBoardsIndex];
+  if (sb->ticks > 0) {
+    ADD_STAT(overwrittenScoreBoardCount, 1);
+  }
+  sb->x = NUM_INT(clamp(x, 0, NUM(VIEW_SIZE_X - 1)));
+  y -= NUM(20);
+  sb->y = NUM_INT(clamp(y, 0, NUM(VIEW_SIZE_Y - 1)));
+  sb->value = NUM_INT(value + NUM(SCORE_VALUE_OFFSET));
   sb->ticks = 30;
-  scoreBoardsIndex++;
-  if (scoreBoardsIndex >= MAX_SCORE_BOARD_COUNT) {
-    scoreBoardsIndex = 0;
+  cglab.scoreBoardsIndex++;
+  if (cglab.scoreBoardsIndex >= MAX_SCORE_BOARD_COUNT) {
+    cglab.scoreBoardsIndex = 0;
   }
 }
 
 static void drawScore(void) {
   saveCurrentColor();
   color = DEFAULT_COLOR;
-  char sc[9];
-  sprintf(sc, "%d", (uint16_t)score);
-  drawCharacters(sc, 3, 3, false, true);
+  char fallback[9];
+  char *sc = frameAlloc(sizeof(fallback));
+  if (!sc) {
+    sc = fallback;
+  }
+  sprintf(sc, "%d", (uint16_t)NUM_INT(score));
+  drawCharacters(sc, NUM(3), NUM(3), false, true);
   sc[0] = 'H';
   sc[1] = 'I';
   sc[2] = ' ';
-  uint8_t ll = sprintf(sc + 3, "%d", hiScore) + 3;
-  drawCharacters(sc, VIEW_SIZE_X - ll * 6 + 2, 3, false, true);
+  uint8_t ll = sprintf(sc + 3, "%d", cglab.hiScore) + 3;
+  drawCharacters(sc, NUM(VIEW_SIZE_X - ll * 6 + 2), NUM(3), false, true);
   loadCurrentColor();
 }
 
 //! Add particles.
-void particle(float x, float y, float count, float speed, float angle,
-              float angleWidth) {
-  addParticle(x, y, count, speed, angle, angleWidth);
+void particle(Number x, Number y, Number count, Number speed, Number angle,
+              Number angleWidth) {
+  addParticle(&cglab.particlePool, x, y, count, speed, angle, angleWidth);
 }
 
 // Input
-static uint8_t input = ~0;
-static uint8_t lastInput;
+static void flushRecordedRun(void) {
+  if (cglab.recordCount == 0) {
+    return;
+  }
+  if (cglab.recordIndex + 2 < cglab.recordBufferSize) {
+    cglab.recordBuffer[cglab.recordIndex++] = cglab.recordCount;
+    cglab.recordBuffer[cglab.recordIndex++] = cglab.recordedInput;
+  } else {
+    // The buffer is full, keep the rest for the end mark only.
+    cglab.recordBufferSize = cglab.recordIndex + 1;
+    cglab.isRecordFull = true;
+  }
+  cglab.recordCount = 0;
+}
+
+static void recordInput(void) {
+  if (cglab.recordCount > 0 &&
+      (cglab.input != cglab.recordedInput || cglab.recordCount == 0xFF)) {
+    flushRecordedRun();
+  }
+  cglab.recordedInput = cglab.input;
+  cglab.recordCount++;
+}
+
+static uint8_t readReplayInput(void) {
+  if (cglab.replayCount == 0) {
+    cglab.replayCount = pgm_read_byte(cglab.replayData++);
+    if (cglab.replayCount == 0) {
+      cglab.replayData = NULL;
+      return md_getInputState();
+    }
+    cglab.replayInput = pgm_read_byte(cglab.replayData++);
+  }
+  cglab.replayCount--;
+  return cglab.replayInput;
+}
 
 static void updateInput(void) {
-  lastInput = input;
-  input = md_getInputState();
+  cglab.lastInput = cglab.input;
+  cglab.input = cglab.replayData ? readReplayInput() : md_getInputState();
+  if (cglab.recordBuffer) {
+    recordInput();
+  }
 }
 
 //! Whether the button is being pressed. Button are `INPUT_*`.
 bool btn(uint8_t button) {
-  return input & button;
+  return cglab.input & button;
 }
 
 //! Whether the button is just pressed now. Button are `INPUT_*`.
 bool btnp(uint8_t button) {
-  return input & (input ^ lastInput) & button;
+  return cglab.input & (cglab.input ^ cglab.lastInput) & button;
 }
 
 //! Whether the button is just released now. Button are `INPUT_*`.
 bool btnr(uint8_t button) {
-  return ~input & (input ^ lastInput) & button;
+  return ~cglab.input & (cglab.input ^ cglab.lastInput) & button;
 }
 
 // Utilities
 //! Get a random float value of [low, high).
-float rnd(float low, float high) {
-  return (float)(rand() & 0x7FFF) / (float)0x7FFF * (high - low) + low;
+Number rnd(Number low, Number high) {
+#ifdef CGLAB_FIXED_POINT
+  Number w = high - low;
+  bool isNegative = w < 0;
+  uint32_t aw = isNegative ? -w : w;
+  uint16_t r = randomNext(&cglab.randomState) >> 16;
+  Number v = (aw >> 16) * r + (((aw & 0xFFFF) * r) >> 16);
+  return isNegative ? low - v : low + v;
+#else
+  // Fill the mantissa of a float in [1, 2) with random bits.
+  union {
+    uint32_t i;
+    float f;
+  } r;
+  r.i = 0x3F800000UL | (randomNext(&cglab.randomState) >> 9);
+  return (r.f - 1.0f) * (high - low) + low;
+#endif
 }
 
 //! Get a random int value of [low, high - 1].
-int16_t rndi(int16_t low, int16_t high) { return rand() % (high - low) + low; }
+int16_t rndi(int16_t low, int16_t high) {
+  uint16_t r = randomNext(&cglab.randomState) >> 16;
+  return (int16_t)(((uint32_t)r * (uint16_t)(high - low)) >> 16) + low;
+}
+
+//! Set the seed of random numbers. The same seed gives the same sequence of
+//! `rnd()` and `rndi()` on every machine.
+void setRandomSeed(uint32_t seed) {
+  randomSetSeed(&cglab.randomState, seed);
+}
 
 //! Clamp a value to [low, high].
-float clamp(float v, float low, float high) {
+Number clamp(Number v, Number low, Number high) {
+#ifdef CGLAB_FIXED_POINT
+  return (v < low) ? low : (v > high) ? high : v;
+#else
   return fmaxf(low, fminf(v, high));
+#endif
 }
 
 //! Wrap a value to [low, high).
-float wrap(float v, float low, float high) {
-  float w = high - low;
-  float o = v - low;
+Number wrap(Number v, Number low, Number high) {
+  Number w = high - low;
+  Number o = v - low;
+#ifdef CGLAB_FIXED_POINT
+  if (w <= 0) {
+    return low;
+  }
+  o %= w;
+  return ((o < 0) ? o + w : o) + low;
+#else
   if (o >= 0) {
     return fmodf(o, w) + low;
   } else {
@@ -568,48 +834,58 @@ float wrap(float v, float low, float high) {
     }
     return wv;
   }
+#endif
 }
 
 // In game
 static void resetDrawState(void) {
   resetColor();
-  thickness = 3;
-  barCenterPosRatio = 0.5f;
+  thickness = NUM(3);
+  barCenterPosRatio = NUM(0.5f);
   hasCollision = true;
 }
 
 static void initInGame(void) {
-  state = STATE_IN_GAME;
-  if (score > hiScore) {
-    hiScore = score;
+  cglab.state = STATE_IN_GAME;
+  TRACE(TRACE_STATE, STATE_IN_GAME);
+  if (score > NUM(cglab.hiScore)) {
+    cglab.hiScore = NUM_INT(score);
   }
   score = 0;
   initScoreBoards();
-  initParticle();
+  initParticle(&cglab.particlePool);
   resetDrawState();
-  soundType = -1;
+  initSound();
+  playSoundPattern(BGM);
   ticks = -1;
 }
 
 static void updateInGame(void) {
   clearView();
-  update();
-  updateParticles();
+  MARK_PHASE(PHASE_UPDATE);
+  cglab.update();
+  MARK_PHASE(PHASE_PARTICLES);
+  updateParticles(&cglab.particlePool, cglab.isRendering);
+  MARK_PHASE(PHASE_SCORE_BOARDS);
   updateScoreBoards();
+  MARK_PHASE(PHASE_ENGINE);
 }
 
 // Title
 /// \cond
+#ifndef MAX_DESCRIPTION_LINE_COUNT
 #define MAX_DESCRIPTION_LINE_COUNT 5
+#endif
+// The lines below go off the screen.
+#if MAX_DESCRIPTION_LINE_COUNT < 1 || MAX_DESCRIPTION_LINE_COUNT > 5
+#error "MAX_DESCRIPTION_LINE_COUNT must be from 1 to 5"
+#endif
 #define MAX_DESCRIPTION_STRLEN 21
 /// \endcond
-static uint8_t descriptionLineCount;
-static int8_t descriptionX;
-
 static void parseDescription(void) {
-  descriptionLineCount = 0;
+  cglab.descriptionLineCount = 0;
   uint8_t dl = 0, ll;
-  const char *line = description;
+  const char *line = cglab.description;
   while ((ll = strlen_P(line)) > 0) {
     uint8_t lln = ll;
     if (lln > MAX_DESCRIPTION_STRLEN) {
@@ -618,29 +894,31 @@ static void parseDescription(void) {
     if (lln > dl) {
       dl = lln;
     }
-    descriptionLineCount++;
-    if (descriptionLineCount >= MAX_DESCRIPTION_LINE_COUNT) {
+    cglab.descriptionLineCount++;
+    if (cglab.descriptionLineCount >= MAX_DESCRIPTION_LINE_COUNT) {
       break;
     }
     line += ll + 1;
   };
-  descriptionX = (VIEW_SIZE_X - (dl - 1) * CHARACTER_WIDTH) / 2;
+  cglab.descriptionX = (VIEW_SIZE_X - (dl - 1) * CHARACTER_WIDTH) / 2;
 }
 
 static void initTitle(void) {
-  state = STATE_TITLE;
+  cglab.state = STATE_TITLE;
+  TRACE(TRACE_STATE, STATE_TITLE);
   ticks = -1;
   resetDrawState();
+  md_stopSound(true);
 }
 
-PROGMEM static const char soundImagePattern[] = {
+PROGMEM static const uint8_t soundImagePattern[] = {
   0x35, 0x35, 0x09, 0x32, 0x04, 0x38,
 };
 
 static void updateTitle(void) {
   if (btnp(INPUT_A | INPUT_B)) {
     md_saveSoundEnabled();
-    srand(rand() ^ ticks);
+    setRandomSeed(randomNext(&cglab.randomState) ^ ticks);
     initInGame();
     return;
   }
@@ -653,20 +931,25 @@ static void updateTitle(void) {
   saveCurrentColor();
   if (!ticks) {
     clearView();
-    drawConstCharacters(title,
-                        (VIEW_SIZE_X - (strlen_P(title) - 1) * CHARACTER_WIDTH) / 2,
-                        VIEW_SIZE_Y * 0.25f, false, true);
+    drawConstCharacters(
+        cglab.title,
+        NUM((VIEW_SIZE_X - (strlen_P(cglab.title) - 1) * CHARACTER_WIDTH) / 2),
+        NUM(VIEW_SIZE_Y * 0.25f), false, true);
   } else if (ticks == 30) {
-    const char *line = description;
-    for (uint8_t i = 0; i < descriptionLineCount; i++) {
-      drawConstCharacters(line, descriptionX,
-                          VIEW_SIZE_Y * 0.55f + i * CHARACTER_HEIGHT, false,
-                          true);
+    const char *line = cglab.description;
+    for (uint8_t i = 0; i < cglab.descriptionLineCount; i++) {
+      drawConstCharacters(line, NUM(cglab.descriptionX),
+                          NUM(VIEW_SIZE_Y * 0.55f) + NUM(i * CHARACTER_HEIGHT),
+                          false, true);
       line += strlen_P(line) + 1;
     }
   }
   color = md_getSoundEnabled() ? LIGHT1 : DARK1;
-  md_drawCharacter(soundImagePattern, 0, VIEW_SIZE_Y - CHARACTER_HEIGHT, color);
+  if (cglab.isRendering) {
+    md_drawCharacter(soundImagePattern, 0, VIEW_SIZE_Y - CHARACTER_HEIGHT,
+                     color);
+    ADD_STAT(characterDrawCount, 1);
+  }
   loadCurrentColor();
 }
 
@@ -674,19 +957,22 @@ static void updateTitle(void) {
 PROGMEM static const char gameOverText[] = "GAME OVER";
 
 static void drawGameOver(void) {
-  float x = (VIEW_SIZE_X - strlen_P(gameOverText) * CHARACTER_WIDTH) / 2;
-  float y = VIEW_SIZE_Y * 0.5f;
+  Number x = NUM((VIEW_SIZE_X - strlen_P(gameOverText) * CHARACTER_WIDTH) / 2);
+  Number y = NUM(VIEW_SIZE_Y * 0.5f);
   color = DARK1;
   for (int8_t i = 1; i <= 7; i += 2) {
-    drawConstCharacters(gameOverText, x + (i % 3) - 1, y + (i / 3) - 1,
-                        false, true);
+    drawConstCharacters(gameOverText, x + NUM((i % 3) - 1),
+                        y + NUM((i / 3) - 1), false, true);
   }
   color = LIGHT1;
   drawConstCharacters(gameOverText, x, y, false, true);
 }
 
 static void initGameOver(void) {
-  state = STATE_GAME_OVER;
+  cglab.state = STATE_GAME_OVER;
+  TRACE(TRACE_STATE, STATE_GAME_OVER);
+  cglab.isRendering = !cglab.isRenderingDisabled;
+  md_stopSound(true);
   saveCurrentColor();
   drawGameOver();
   loadCurrentColor();
@@ -703,6 +989,7 @@ static void updateGameOver(void) {
 
 //! Transit to the game-over state.
 void gameOver(void) {
+  TRACE(TRACE_GAME_OVER, NUM_INT(score));
   initGameOver();
 }
 
@@ -711,45 +998,265 @@ void gameOver(void) {
 void setupGame(const char *_title,
                const char *_description,
                const CharacterData *_characters,
-               const uint8_t **_sounds,
+               const uint8_t *const *_sounds,
                void (*_update)(void)) {
-  title = _title;
-  description = _description;
-  characters = _characters;
-  sounds = _sounds;
-  update = _update;
+  cglab.title = _title;
+  cglab.description = _description;
+  cglab.characters = _characters;
+  cglab.sounds = _sounds;
+  cglab.update = _update;
 }
 
-//! Initialize game.
-void initGame(void) {
-  md_initMachine();
+static void resetGame(void) {
+  cglab.isRendering = !cglab.isRenderingDisabled;
   initScore();
-  initParticle();
-  parseDescription();
+  initParticle(&cglab.particlePool);
   resetDrawState();
   initTitle();
-  soundType = -1;
+  initSound();
   ticks = 0;
+  cglab.input = ~0;
+  cglab.lastInput = 0;
 }
 
+//! Initialize game.
+void initGame(void) {
+  Random random = RANDOM_INITIALIZER;
+  cglab.randomState = random;
+  md_initMachine();
+#ifdef CGLAB_MEMORY_PROBE
+  memset(&memoryStats, 0, sizeof(MemoryStats));
+  memoryStats.minFreeSize = UINT16_MAX;
+#endif
+#ifdef CGLAB_TRACE
+  memset(&engineTrace, 0, sizeof(EngineTrace));
+#endif
+  parseDescription();
+  resetGame();
+}
+
+// Replay
+/// \cond
+#define REPLAY_SEED_SIZE 4
+/// \endcond
+
+static void resetGameWithSeed(uint32_t seed) {
+  setRandomSeed(seed);
+  resetGame();
+}
+
+//! Restart the game from the title and record the inputs of every frame into
+//! `buffer` of `size` bytes. The record starts with the random seed (4 bytes,
+//! little endian) followed by runs of 2 bytes, a frame count (1-255) and an
+//! input state, and ends with a zero frame count.
+void startInputRecording(uint8_t *buffer, uint16_t size) {
+  if (size <= REPLAY_SEED_SIZE) {
+    return;
+  }
+  uint32_t seed = randomNext(&cglab.randomState);
+  for (uint8_t i = 0; i < REPLAY_SEED_SIZE; i++) {
+    buffer[i] = seed >> (i * 8);
+  }
+  cglab.recordBuffer = buffer;
+  cglab.recordBufferSize = size;
+  cglab.recordIndex = REPLAY_SEED_SIZE;
+  cglab.recordCount = 0;
+  cglab.isRecordFull = false;
+  cglab.replayData = NULL;
+  resetGameWithSeed(seed);
+}
+
+//! Stop recording. Returns the size of the record in bytes, or 0 if the
+//! buffer got full. The buffer then still holds a record that ends at the
+//! frame where it got full.
+uint16_t stopInputRecording(void) {
+  if (!cglab.recordBuffer) {
+    return 0;
+  }
+  flushRecordedRun();
+  cglab.recordBuffer[cglab.recordIndex++] = 0;
+  cglab.recordBuffer = NULL;
+  return cglab.isRecordFull ? 0 : cglab.recordIndex;
+}
+
+//! Restart the game from the title and replay a record made by
+//! `startInputRecording()` from PROGMEM instead of the buttons. The buttons
+//! are used again after the end of the record.
+void startInputReplay(const uint8_t *replay) {
+  uint32_t seed = 0;
+  for (uint8_t i = 0; i < REPLAY_SEED_SIZE; i++) {
+    seed |= (uint32_t)pgm_read_byte(&replay[i]) << (i * 8);
+  }
+  cglab.recordBuffer = NULL;
+  cglab.replayData = replay + REPLAY_SEED_SIZE;
+  cglab.replayCount = 0;
+  resetGameWithSeed(seed);
+}
+
+//! Whether a record is being replayed.
+bool isInputReplaying(void) {
+  return cglab.replayData != NULL;
+}
+
+#ifdef CGLAB_STATS
+static void endFrameStats(void) {
+  engineStats.frame.hitBoxCount = cglab.hitBoxesIndex;
+  engineStats.frame.frameArenaSize =
+      cglab.hitBoxesIndex * sizeof(HitBox) + cglab.frameScratchSize;
+  uint16_t *frame = (uint16_t *)&engineStats.frame;
+  uint16_t *max = (uint16_t *)&engineStats.max;
+  for (uint8_t i = 0; i < sizeof(FrameStats) / sizeof(uint16_t); i++) {
+    if (frame[i] > max[i]) {
+      max[i] = frame[i];
+    }
+  }
+}
+#endif
+
+#ifdef CGLAB_MEMORY_PROBE
+// The stack used in the frame counts for the state at the start of it.
+static void endMemoryProbe(uint8_t state) {
+  uint16_t freeSize;
+  uint16_t stackSize = md_measureStack(&freeSize);
+  memoryStats.frameStackSize = stackSize;
+  if (stackSize > memoryStats.maxStackSizes[state]) {
+    memoryStats.maxStackSizes[state] = stackSize;
+  }
+  if (freeSize < memoryStats.minFreeSize) {
+    memoryStats.minFreeSize = freeSize;
+  }
+}
+#endif
+
+#ifdef CGLAB_HIT_BOX_OVERLAY
+// Outline the stored hit boxes in INVERT, and drawing them again erases them.
+static void drawHitBoxes(void) {
+  for (uint8_t i = 0; i < cglab.hitBoxesIndex; i++) {
+    HitBox *hb = &cglab.hitBoxes[i];
+    md_drawRect(hb->x, hb->y, hb->w, 1, INVERT1);
+    if (hb->h > 1) {
+      md_drawRect(hb->x, hb->y + hb->h - 1, hb->w, 1, INVERT1);
+    }
+    if (hb->h > 2) {
+      md_drawRect(hb->x, hb->y + 1, 1, hb->h - 2, INVERT1);
+      if (hb->w > 1) {
+        md_drawRect(hb->x + hb->w - 1, hb->y + 1, 1, hb->h - 2, INVERT1);
+      }
+    }
+  }
+}
+#endif
+
 //! Update game frames if it's every 1/60 second timing.
 bool updateGame(void) {
   if (!md_nextFrame()) {
     return false;
   }
-  hitBoxesIndex = 0;
-  difficulty = (float)ticks / 60 / FPS + 1;
+  MARK_PHASE(PHASE_ENGINE);
+#ifdef CGLAB_STATS
+  memset(&engineStats.frame, 0, sizeof(FrameStats));
+#endif
+#ifdef CGLAB_MEMORY_PROBE
+  uint8_t frameState = cglab.state;
+#endif
+#ifdef CGLAB_TRACE
+  engineTrace.hasHitBoxOverflow = false;
+#endif
+  TRACE(TRACE_FRAME_BEGIN, ticks);
+#ifdef CGLAB_FRAME_SKIP
+  // Skip drawing a frame in game after an overrun, but not two in a row.
+  if (cglab.isRendering && cglab.state == STATE_IN_GAME &&
+      md_isFrameOverrun()) {
+    cglab.isRendering = false;
+    skippedFrameCount++;
+  } else {
+    cglab.isRendering = !cglab.isRenderingDisabled;
+  }
+#else
+  cglab.isRendering = !cglab.isRenderingDisabled;
+#endif
+  cglab.hitBoxesIndex = 0;
+  cglab.frameScratchSize = 0;
+  difficulty = NUM(ticks) / 60 / FPS + NUM(1);
   updateInput();
-  if (state == STATE_TITLE) {
+  if (cglab.state == STATE_TITLE) {
     updateTitle();
-  } else if (state == STATE_IN_GAME) {
+  } else if (cglab.state == STATE_IN_GAME) {
     updateInGame();
-  } else if (state == STATE_GAME_OVER) {
+  } else if (cglab.state == STATE_GAME_OVER) {
     updateGameOver();
   }
   updateSound();
-  drawScore();
+  MARK_PHASE(PHASE_DRAW_SCORE);
+  if (cglab.isRendering) {
+    drawScore();
+  }
   ticks++;
-  md_refresh();
+#ifdef CGLAB_STATS
+  endFrameStats();
+#endif
+  MARK_PHASE(PHASE_PRESENT);
+  if (cglab.isRendering) {
+#ifdef CGLAB_HIT_BOX_OVERLAY
+    drawHitBoxes();
+    md_refresh();
+    drawHitBoxes();
+#else
+    md_refresh();
+#endif
+  }
+#ifdef CGLAB_MEMORY_PROBE
+  endMemoryProbe(frameState);
+#endif
+  TRACE(TRACE_FRAME_END, engineStats.frame.rectDrawCount +
+                             engineStats.frame.characterDrawCount +
+                             engineStats.frame.pixelDrawCount);
+  MARK_PHASE(PHASE_IDLE);
   return true;
 }
+
+// Context
+//! Save the state of the game in use to `context`.
+void saveContext(CglabContext *context) {
+  context->ticks = ticks;
+  context->score = score;
+  context->difficulty = difficulty;
+  context->color = color;
+  context->thickness = thickness;
+  context->barCenterPosRatio = barCenterPosRatio;
+  context->hasCollision = hasCollision;
+  context->soundStartDelay = soundStartDelay;
+#ifdef CGLAB_FRAME_SKIP
+  context->skippedFrameCount = skippedFrameCount;
+#endif
+#ifdef CGLAB_STATS
+  context->engineStats = engineStats;
+#endif
+  context->engine = cglab;
+}
+
+//! Load a game saved by `saveContext()` to use it. The frame buffer and the
+//! sound of the machine are not in the context.
+void loadContext(const CglabContext *context) {
+  ticks = context->ticks;
+  score = context->score;
+  difficulty = context->difficulty;
+  color = context->color;
+  thickness = context->thickness;
+  barCenterPosRatio = context->barCenterPosRatio;
+  hasCollision = context->hasCollision;
+  soundStartDelay = context->soundStartDelay;
+#ifdef CGLAB_FRAME_SKIP
+  skippedFrameCount = context->skippedFrameCount;
+#endif
+#ifdef CGLAB_STATS
+  engineStats = context->engineStats;
+#endif
+  cglab = context->engine;
+}
+
+//! The state of the game in use, `STATE_TITLE`, `STATE_IN_GAME` or
+//! `STATE_GAME_OVER`.
+uint8_t getGameState(void) {
+  return cglab.state;
+}
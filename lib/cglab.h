@@ -11,6 +11,8 @@
 #include <Arduino.h>
 
 #include "machineDependent.h"
+#include "particle.h"
+#include "random.h"
 #include "vector.h"
 
 enum COLOR_ENUM {
@@ -51,6 +53,25 @@ enum SOUND_ENUM {
 #define HIT_BOX_INDEX_TEXT_BASE      (HIT_BOX_INDEX_COLOR_BASE + COLOR_COUNT)
 #define HIT_BOX_INDEX_CHARACTER_BASE (HIT_BOX_INDEX_TEXT_BASE + TEXT_PATTERN_COUNT)
 
+// The sizes of the pools, which a sketch can set in cglabConfig.h.
+#ifndef MAX_HIT_BOX_COUNT
+#define MAX_HIT_BOX_COUNT 120
+#endif
+#if MAX_HIT_BOX_COUNT < 1 || MAX_HIT_BOX_COUNT > 255
+#error "MAX_HIT_BOX_COUNT must be from 1 to 255"
+#endif
+// Bytes of the frame arena for frameAlloc() over the hit boxes, at least the
+// texts of the score and of a score board (9 and 6 bytes).
+#ifndef CGLAB_FRAME_SCRATCH_SIZE
+#define CGLAB_FRAME_SCRATCH_SIZE 16
+#endif
+#ifndef MAX_SCORE_BOARD_COUNT
+#define MAX_SCORE_BOARD_COUNT 4
+#endif
+#if MAX_SCORE_BOARD_COUNT < 1 || MAX_SCORE_BOARD_COUNT > 255
+#error "MAX_SCORE_BOARD_COUNT must be from 1 to 255"
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -72,49 +93,232 @@ typedef struct {
   uint16_t isColliding[8];
 } Collision;
 
+typedef struct {
+  uint8_t lastFrames;
+  uint8_t maxFrames;
+  uint16_t totalFrames;
+  uint16_t startedCount;
+  uint16_t droppedCount;
+} SoundStartDelay;
+
+typedef struct {
+  uint16_t hitBoxCount;
+  uint16_t droppedHitBoxCount;
+  uint16_t hitBoxTestCount;
+  uint16_t rectDrawCount;
+  uint16_t characterDrawCount;
+  uint16_t pixelDrawCount;
+  uint16_t evictedParticleCount;
+  uint16_t overwrittenScoreBoardCount;
+  uint16_t frameArenaSize;
+  uint16_t failedFrameAllocCount;
+} FrameStats;
+
+typedef struct {
+  FrameStats frame;
+  FrameStats max;
+} EngineStats;
+
+#ifdef CGLAB_TRACE
+typedef struct {
+  TraceEvent events[CGLAB_TRACE_SIZE];
+  uint8_t index;
+  bool isWrapped;
+  bool hasHitBoxOverflow;
+} EngineTrace;
+#endif
+
+/// \cond
+enum STATE_ENUM {
+  STATE_TITLE = 0,
+  STATE_IN_GAME,
+  STATE_GAME_OVER,
+  STATE_COUNT,
+};
+/// \endcond
+
+typedef struct {
+  uint16_t frameStackSize;
+  uint16_t maxStackSizes[STATE_COUNT];
+  uint16_t minFreeSize;
+} MemoryStats;
+
+/// \cond
+
+typedef struct {
+  uint8_t index;
+  int8_t  x;
+  int8_t  y;
+  uint8_t w;
+  uint8_t h;
+} HitBox;
+
+typedef struct {
+  uint32_t value:14;
+  uint32_t x:7;
+  uint32_t y:6;
+  uint32_t ticks:5;
+} ScoreBoard;
+
+#define FRAME_ARENA_SIZE \
+  (MAX_HIT_BOX_COUNT * sizeof(HitBox) + CGLAB_FRAME_SCRATCH_SIZE)
+
+// The state of the engine other than the variables of the API. It is in one
+// struct so that a context is saved and loaded with a copy, and is zero at
+// the start so that it stays out of the initialized data.
+typedef struct {
+  uint8_t state;
+  bool isRenderingDisabled;
+  bool isRendering;
+
+  const char *title;
+  const char *description;
+  const CharacterData *characters;
+  const uint8_t *const *sounds;
+  void (*update)(void);
+
+  // The hit boxes from the bottom and the blocks of frameAlloc() from the top.
+  union {
+    HitBox hitBoxes[FRAME_ARENA_SIZE / sizeof(HitBox)];
+    uint8_t frameArena[FRAME_ARENA_SIZE];
+  };
+  uint16_t frameScratchSize;
+  uint8_t hitBoxesIndex;
+  uint8_t drawingHitBoxesIndex;
+  uint8_t savedColor;
+
+  uint16_t requestedSounds;
+  uint8_t requestedFrames[SOUND_EFFECT_TYPE_COUNT];
+  int8_t playingSoundType;
+  uint8_t soundFrameCount;
+
+  uint16_t hiScore;
+  ScoreBoard scoreBoards[MAX_SCORE_BOARD_COUNT];
+  uint8_t scoreBoardsIndex;
+  ParticlePool particlePool;
+
+  uint8_t input;
+  uint8_t lastInput;
+  uint8_t *recordBuffer;
+  uint16_t recordBufferSize;
+  uint16_t recordIndex;
+  uint8_t recordedInput;
+  uint8_t recordCount;
+  bool isRecordFull;
+  const uint8_t *replayData;
+  uint8_t replayInput;
+  uint8_t replayCount;
+
+  Random randomState;
+  uint8_t descriptionLineCount;
+  int8_t descriptionX;
+} CglabEngine;
+/// \endcond
+
+//! The whole state of a game, the variables of the API and the engine, for
+//! stepping more than one game in turn with `loadContext()` and
+//! `saveContext()`. A zero filled context is a new one, which is set up with
+//! `setupGame()` and `initGame()` after loading it. The variables of each
+//! game itself are not in the context, so the games stepped in turn are
+//! different ones.
+//! The game in use is not behind a pointer but in the variables of the
+//! library, so the library is not reentrant, and switching the games copies
+//! the whole context out and in (920 bytes on the host, about 840 on the
+//! Arduboy with the default sizes of the pools).
+typedef struct {
+  uint16_t ticks;
+  Number score;
+  Number difficulty;
+  int8_t color;
+  Number thickness;
+  Number barCenterPosRatio;
+  bool hasCollision;
+  SoundStartDelay soundStartDelay;
+#ifdef CGLAB_FRAME_SKIP
+  uint16_t skippedFrameCount;
+#endif
+#ifdef CGLAB_STATS
+  EngineStats engineStats;
+#endif
+  CglabEngine engine;
+} CglabContext;
+
 /// \cond
 EXTERNC uint16_t ticks;
-EXTERNC float score;
-EXTERNC float difficulty;
+EXTERNC Number score;
+EXTERNC Number difficulty;
 EXTERNC int8_t color;
-EXTERNC float thickness;
-EXTERNC float barCenterPosRatio;
+EXTERNC Number thickness;
+EXTERNC Number barCenterPosRatio;
 EXTERNC bool hasCollision;
+EXTERNC SoundStartDelay soundStartDelay;
+#ifdef CGLAB_FRAME_SKIP
+EXTERNC uint16_t skippedFrameCount;
+#endif
+#ifdef CGLAB_STATS
+EXTERNC EngineStats engineStats;
+#define ADD_STAT(name, count) (engineStats.frame.name += (count))
+#else
+#define ADD_STAT(name, count)
+#endif
+#ifdef CGLAB_MEMORY_PROBE
+EXTERNC MemoryStats memoryStats;
+#endif
+#ifdef CGLAB_TRACE
+EXTERNC EngineTrace engineTrace;
+#endif
 
 EXTERNC bool colRect(Collision *cl, uint8_t color);
 EXTERNC bool colText(Collision *cl, char text);
 EXTERNC bool colCharacter(Collision *cl, char character);
-EXTERNC Collision rect(float x, float y, float w, float h);
-EXTERNC Collision box(float x, float y, float w, float h);
-EXTERNC Collision line(float x1, float y1, float x2, float y2);
-EXTERNC Collision bar(float x, float y, float length, float angle);
-EXTERNC Collision arc(float centerX, float centerY, float radius,
-                      float angleFrom, float angleTo);
-EXTERNC Collision text(char *msg, float x, float y);
-EXTERNC Collision constText(const char *msg, float x, float y);
-EXTERNC Collision character(char character, float x, float y);
+EXTERNC Collision rect(Number x, Number y, Number w, Number h);
+EXTERNC Collision box(Number x, Number y, Number w, Number h);
+EXTERNC Collision line(Number x1, Number y1, Number x2, Number y2);
+EXTERNC Collision bar(Number x, Number y, Number length, Number angle);
+EXTERNC Collision arc(Number centerX, Number centerY, Number radius,
+                      Number angleFrom, Number angleTo);
+EXTERNC Collision text(char *msg, Number x, Number y);
+EXTERNC Collision constText(const char *msg, Number x, Number y);
+EXTERNC Collision character(char character, Number x, Number y);
 EXTERNC void play(uint8_t type);
-EXTERNC void addScore(float value, float x, float y);
-EXTERNC float rnd(float high, float low);
-EXTERNC int16_t rndi(int16_t high, int16_t low);
+EXTERNC void addScore(Number value, Number x, Number y);
+EXTERNC Number rnd(Number low, Number high);
+EXTERNC int16_t rndi(int16_t low, int16_t high);
+EXTERNC void setRandomSeed(uint32_t seed);
 EXTERNC void gameOver(void);
-EXTERNC void particle(float x, float y, float count, float speed, float angle,
-                      float angleWidth);
+EXTERNC void particle(Number x, Number y, Number count, Number speed,
+                      Number angle, Number angleWidth);
+EXTERNC void *frameAlloc(uint16_t size);
 EXTERNC bool btn(uint8_t button);
 EXTERNC bool btnp(uint8_t button);
 EXTERNC bool btnr(uint8_t button);
 
-EXTERNC float clamp(float v, float low, float high);
-EXTERNC float wrap(float v, float low, float high);
+EXTERNC Number clamp(Number v, Number low, Number high);
+EXTERNC Number wrap(Number v, Number low, Number high);
 EXTERNC void enableSound(void);
 EXTERNC void disableSound(void);
 EXTERNC void toggleSound(void);
+EXTERNC void enableRendering(void);
+EXTERNC void disableRendering(void);
 
 EXTERNC void setupGame(const char *title, const char *description,
-                       const CharacterData *characters, const uint8_t **sounds,
-                       void (*update)(void));
+                       const CharacterData *characters,
+                       const uint8_t *const *sounds, void (*update)(void));
 EXTERNC void initGame(void);
 EXTERNC bool updateGame(void);
+
+EXTERNC void startInputRecording(uint8_t *buffer, uint16_t size);
+EXTERNC uint16_t stopInputRecording(void);
+EXTERNC void startInputReplay(const uint8_t *replay);
+EXTERNC bool isInputReplaying(void);
+
+#ifdef CGLAB_TRACE
+EXTERNC void dumpTrace(void);
+#endif
+
+EXTERNC void saveContext(CglabContext *context);
+EXTERNC void loadContext(const CglabContext *context);
+EXTERNC uint8_t getGameState(void);
 /// \endcond
 
 //! Iterate over an `array` with variable `index`
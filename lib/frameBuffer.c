@@ -0,0 +1,49 @@
+#include "frameBuffer.h"
+
+#include <Arduino.h>
+
+#include "machineDependent.h"
+
+void drawPixelToBuffer(uint8_t *buffer, int16_t x, int16_t y, uint8_t color) {
+  /*  Check parameters  */
+  if (x < 0 || x >= VIEW_SIZE_X || y < 0 || y >= VIEW_SIZE_Y) return;
+
+  /*  Draw a pixel  */
+  uint8_t *p = buffer + x + (y / 8) * VIEW_SIZE_X;
+  uint8_t d = bit(y & 7);
+  if (color != FRAME_BUFFER_INVERT) *p |= d;
+  if (color != FRAME_BUFFER_WHITE) *p ^= d;
+}
+
+void drawRectToBuffer(uint8_t *buffer, int16_t x, int16_t y,
+                      int16_t w, int16_t h, uint8_t color) {
+  /*  Check parameters  */
+  if (x < 0) {
+    if (w <= -x) return;
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    if (h <= -y) return;
+    h += y;
+    y = 0;
+  }
+  if (w <= 0 || x >= VIEW_SIZE_X || h <= 0 || y >= VIEW_SIZE_Y) return;
+  if (x + w > VIEW_SIZE_X) w = VIEW_SIZE_X - x;
+  if (y + h > VIEW_SIZE_Y) h = VIEW_SIZE_Y - y;
+
+  /*  Draw a filled rectangle  */
+  uint8_t *p = buffer + x + (y / 8) * VIEW_SIZE_X;
+  uint8_t yOdd = y & 7, d = 0xFF << yOdd;
+  for (h += yOdd; h > 0; h -= 8, p += VIEW_SIZE_X - w) {
+    if (h < 8) d &= 0xFF >> (8 - h);
+    if (color == FRAME_BUFFER_WHITE) {
+      for (uint8_t i = w; i > 0; i--, *p++ |= d) { ; }
+    } else if (color == FRAME_BUFFER_BLACK) {
+      for (uint8_t i = w, invD = ~d; i > 0; i--, *p++ &= invD) { ; }
+    } else {
+      for (uint8_t i = w; i > 0; i--, *p++ ^= d) { ; }
+    }
+    d = 0xFF;
+  }
+}
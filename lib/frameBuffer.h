@@ -0,0 +1,26 @@
+/// \cond
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#ifdef __cplusplus
+#define EXTERNC extern "C"
+#else
+#define EXTERNC extern
+#endif
+
+#include <stdint.h>
+
+/*  The 1 KB frame buffer of the display is in pages of 8 rows, a byte is a
+ *  column of 8 pixels in a page with the top pixel in the lowest bit.
+ *  Colors are the values of Arduboy2's BLACK, WHITE and INVERT.  */
+#define FRAME_BUFFER_BLACK  0
+#define FRAME_BUFFER_WHITE  1
+#define FRAME_BUFFER_INVERT 2
+
+EXTERNC void drawPixelToBuffer(uint8_t *buffer, int16_t x, int16_t y,
+                               uint8_t color);
+EXTERNC void drawRectToBuffer(uint8_t *buffer, int16_t x, int16_t y,
+                              int16_t w, int16_t h, uint8_t color);
+/// \endcond
+
+#endif
@@ -0,0 +1,84 @@
+#include "frameProfile.h"
+
+#include <Arduino.h>
+
+#include "frameBuffer.h"
+
+void initFrameProfile(FrameProfile *profile) {
+  memset(profile, 0, sizeof(FrameProfile));
+  startProfileWindow(profile);
+}
+
+static void resetProfileStat(ProfileStat *stat) {
+  stat->min = UINT16_MAX;
+  stat->max = 0;
+  stat->total = 0;
+}
+
+// Start a new window, the bars of the last window are kept.
+void startProfileWindow(FrameProfile *profile) {
+  for (uint8_t i = 0; i < PROFILE_PHASE_COUNT; i++) {
+    resetProfileStat(&profile->phases[i]);
+  }
+  resetProfileStat(&profile->busy);
+  memset(profile->histogram, 0, sizeof(profile->histogram));
+  profile->frameCount = 0;
+}
+
+void addProfileTicks(FrameProfile *profile, uint8_t phase, uint16_t ticks) {
+  uint16_t *p = &profile->frameTicks[phase];
+  *p = (*p > UINT16_MAX - ticks) ? UINT16_MAX : *p + ticks;
+}
+
+static void addProfileStat(ProfileStat *stat, uint16_t ticks) {
+  if (ticks < stat->min) stat->min = ticks;
+  if (ticks > stat->max) stat->max = ticks;
+  stat->total += ticks;
+}
+
+static uint8_t getBarWidth(uint32_t ticks, uint16_t budgetTicks) {
+  uint32_t width = ticks * PROFILE_BAR_WIDTH / budgetTicks;
+  return (width > PROFILE_BAR_WIDTH) ? PROFILE_BAR_WIDTH : width;
+}
+
+// End the frame. Returns true at the end of the window.
+bool endProfileFrame(FrameProfile *profile, uint16_t budgetTicks) {
+  uint16_t busyTicks = 0;
+  for (uint8_t i = 0; i < PROFILE_PHASE_COUNT; i++) {
+    uint16_t ticks = profile->frameTicks[i];
+    addProfileStat(&profile->phases[i], ticks);
+    busyTicks = (busyTicks > UINT16_MAX - ticks) ? UINT16_MAX
+                                                 : busyTicks + ticks;
+  }
+  memset(profile->frameTicks, 0, sizeof(profile->frameTicks));
+  addProfileStat(&profile->busy, busyTicks);
+  uint8_t bin = PROFILE_HISTOGRAM_COUNT - 1;
+  if (busyTicks < budgetTicks) {
+    bin = busyTicks / ((budgetTicks + PROFILE_HISTOGRAM_COUNT - 2) /
+                       (PROFILE_HISTOGRAM_COUNT - 1));
+  }
+  profile->histogram[bin]++;
+  if (++profile->frameCount < PROFILE_WINDOW_FRAMES) {
+    return false;
+  }
+  for (uint8_t i = 0; i < PROFILE_PHASE_COUNT; i++) {
+    profile->bars[i] = getBarWidth(
+        profile->phases[i].total / PROFILE_WINDOW_FRAMES, budgetTicks);
+  }
+  profile->bars[PROFILE_PHASE_COUNT] =
+      getBarWidth(profile->busy.total / PROFILE_WINDOW_FRAMES, budgetTicks);
+  profile->bars[PROFILE_PHASE_COUNT + 1] =
+      getBarWidth(profile->busy.max, budgetTicks);
+  return true;
+}
+
+// Draw the bars in the bottom right corner, a row of a pixel for each.
+// Drawing it again erases it.
+void drawFrameProfile(uint8_t *buffer, const FrameProfile *profile) {
+  int16_t x = VIEW_SIZE_X - PROFILE_BAR_WIDTH;
+  int16_t y = VIEW_SIZE_Y - PROFILE_BAR_COUNT;
+  for (uint8_t i = 0; i < PROFILE_BAR_COUNT; i++) {
+    drawRectToBuffer(buffer, x, y + i, profile->bars[i], 1,
+                     FRAME_BUFFER_INVERT);
+  }
+}
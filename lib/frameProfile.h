@@ -0,0 +1,51 @@
+/// \cond
+#ifndef FRAME_PROFILE_H
+#define FRAME_PROFILE_H
+
+#ifdef __cplusplus
+#define EXTERNC extern "C"
+#else
+#define EXTERNC extern
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "machineDependent.h"
+
+#define PROFILE_WINDOW_FRAMES   60
+#define PROFILE_PHASE_COUNT     PHASE_IDLE
+#define PROFILE_HISTOGRAM_COUNT 9
+#define PROFILE_BAR_COUNT       (PROFILE_PHASE_COUNT + 2)
+#define PROFILE_BAR_WIDTH       32
+
+typedef struct {
+  uint16_t min;
+  uint16_t max;
+  uint32_t total;
+} ProfileStat;
+
+/*  The ticks of the phases other than idle are counted in each frame, and
+ *  their statistics are taken in a window of PROFILE_WINDOW_FRAMES frames.
+ *  The busy time of a frame is their sum. The histogram of the busy time has
+ *  8 bins of 1/8 of the budget and a bin of over the budget. The bars are the
+ *  average of each phase, the average and the max busy time of the last
+ *  window in PROFILE_BAR_WIDTH pixels for the budget.  */
+typedef struct {
+  uint16_t frameTicks[PHASE_COUNT];
+  ProfileStat phases[PROFILE_PHASE_COUNT];
+  ProfileStat busy;
+  uint16_t histogram[PROFILE_HISTOGRAM_COUNT];
+  uint8_t frameCount;
+  uint8_t bars[PROFILE_BAR_COUNT];
+} FrameProfile;
+
+EXTERNC void initFrameProfile(FrameProfile *profile);
+EXTERNC void startProfileWindow(FrameProfile *profile);
+EXTERNC void addProfileTicks(FrameProfile *profile, uint8_t phase,
+                             uint16_t ticks);
+EXTERNC bool endProfileFrame(FrameProfile *profile, uint16_t budgetTicks);
+EXTERNC void drawFrameProfile(uint8_t *buffer, const FrameProfile *profile);
+/// \endcond
+
+#endif
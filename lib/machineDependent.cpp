@@ -1,16 +1,31 @@
 #include <Arduboy2.h>
 
+#include "frameBuffer.h"
+#include "frameProfile.h"
 #include "machineDependent.h"
+#include "noteTimer.h"
+#include "soundSequence.h"
 
 static void initAudio(void);
 static void closeAudio(void);
 static void playSound(uint8_t chan, const uint8_t *sound);
 static void stopSound(uint8_t chan);
 static void stopAllSounds(void);
+static bool isSoundPlaying(uint8_t chan);
+static void updateSounds(void);
+static void forwardDueSounds(void);
 static void forwardSound(uint8_t chan);
-static uint16_t playNote(uint8_t chan, uint8_t note);
-static uint16_t stopNote(uint8_t chan);
-static void setupSoundTimer(uint8_t chan, uint16_t frequency);
+static void playNote(uint8_t chan, uint8_t note);
+static void stopNote(uint8_t chan);
+static void setupSoundTimer(uint8_t chan, uint8_t note);
+#if defined(CGLAB_PROFILE) && !defined(CGLAB_SIMAVR)
+#define PROFILE_ON_DEVICE
+static void initProfile(void);
+static FrameProfile frameProfile;
+#endif
+#ifdef CGLAB_MEMORY_PROBE
+static void paintFreeStack(void);
+#endif
 
 /*---------------------------------------------------------------------------*/
 
@@ -20,14 +35,36 @@ void md_initMachine(void) {
   arduboy.beginDoFirst();
   arduboy.setFrameRate(FPS);
   initAudio();
+#ifdef PROFILE_ON_DEVICE
+  initProfile();
+#endif
+#ifdef CGLAB_MEMORY_PROBE
+  paintFreeStack();
+#endif
+#ifdef CGLAB_TRACE
+  Serial.begin(9600);
+#endif
 }
 
 bool md_nextFrame(void) {
+  updateSounds();
   return arduboy.nextFrame();
 }
 
+// Whether the last frame took longer than a frame.
+bool md_isFrameOverrun(void) {
+  return arduboy.cpuLoad() >= 100;
+}
+
 void md_refresh(void) {
+  updateSounds();
+#if defined(PROFILE_ON_DEVICE) && defined(CGLAB_PROFILE_OVERLAY)
+  drawFrameProfile(arduboy.getBuffer(), &frameProfile);
+  arduboy.display();
+  drawFrameProfile(arduboy.getBuffer(), &frameProfile);
+#else
   arduboy.display();
+#endif
 }
 
 void md_clearView(void) {
@@ -39,59 +76,26 @@ PROGMEM static const uint8_t colorTable[] = {
 };
 #define getColor(color) (pgm_read_byte(&colorTable[color]))
 
-void md_drawPixel(float _x, float _y, int8_t color) {
-  /*  Check parameters  */
-  int16_t x = (int16_t)_x, y = (int16_t)_y;
-  if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return;
-
-  /*  Draw a pixel  */
-  uint8_t *p = arduboy.getBuffer() + x + (y / 8) * WIDTH;
-  uint8_t d = bit(y & 7), c = getColor(color);
-  if (c != INVERT) *p |= d;
-  if (c != WHITE) *p ^= d;
-}
-
-void md_drawRect(float _x, float _y, float _w, float _h, int8_t color) {
-  /*  Check parameters  */
-  int16_t x = (int16_t)_x, y = (int16_t)_y, w = (int16_t)_w, h = (int16_t)_h;
-  if (x < 0) {
-    if (w <= -x) return;
-    w += x;
-    x = 0;
-  }
-  if (y < 0) {
-    if (h <= -y) return;
-    h += y;
-    y = 0;
-  }
-  if (w <= 0 || x >= WIDTH || h <= 0 || y >= HEIGHT) return;
-  if (x + w > WIDTH) w = WIDTH - x;
-  if (y + h > HEIGHT) h = HEIGHT - y;
-
-  /*  Draw a filled rectangle  */
-  uint8_t *p = arduboy.getBuffer() + x + (y / 8) * WIDTH;
-  uint8_t yOdd = y & 7, d = 0xFF << yOdd, c = getColor(color);
-  for (h += yOdd; h > 0; h -= 8, p += WIDTH - w) {
-    if (h < 8) d &= 0xFF >> (8 - h);
-    if (c == WHITE) {
-      for (uint8_t i = w; i > 0; i--, *p++ |= d) { ; }
-    } else if (c == BLACK) {
-      for (uint8_t i = w, invD = ~d; i > 0; i--, *p++ &= invD) { ; }
-    } else {
-      for (uint8_t i = w; i > 0; i--, *p++ ^= d) { ; }
-    }
-    d = 0xFF;
-  }
+void md_drawPixel(int16_t x, int16_t y, int8_t color) {
+  drawPixelToBuffer(arduboy.getBuffer(), x, y, getColor(color));
+}
+
+void md_drawRect(int16_t x, int16_t y, int16_t w, int16_t h, int8_t color) {
+  drawRectToBuffer(arduboy.getBuffer(), x, y, w, h, getColor(color));
 }
 
-void md_drawCharacter(const uint8_t grid[CHARACTER_WIDTH], float x, float y,
+void md_drawCharacter(const uint8_t grid[CHARACTER_WIDTH], int16_t x, int16_t y,
                       int8_t color) {
-  arduboy.drawBitmap((int16_t)x, (int16_t)y, grid,
+  arduboy.drawBitmap(x, y, grid,
                      CHARACTER_WIDTH, CHARACTER_HEIGHT, getColor(color));
 }
 
 uint8_t md_getInputState(void) {
+#ifdef CGLAB_SIMAVR
+  return GPIOR2;
+#else
   return arduboy.buttonsState();
+#endif
 }
 
 bool md_getSoundEnabled(void) {
@@ -106,13 +110,235 @@ void md_saveSoundEnabled(void) {
   arduboy.audio.saveOnOff();
 }
 
+static volatile bool isSoundBusy;
+
 void md_playSound(const uint8_t *sound, bool isBgm) {
+  isSoundBusy = true;
   playSound(isBgm ? 1 : 0, sound);
+  isSoundBusy = false;
 }
 
 void md_stopSound(bool isBgm) {
+  isSoundBusy = true;
   stopSound(isBgm ? 1 : 0);
+  isSoundBusy = false;
+}
+
+bool md_isSoundPlaying(bool isBgm) {
+  return isSoundPlaying(isBgm ? 1 : 0);
+}
+
+#ifdef CGLAB_SIMAVR
+void md_markPhase(uint8_t phase) {
+  GPIOR1 = phase;
+}
+#elif defined(PROFILE_ON_DEVICE)
+
+/*---------------------------------------------------------------------------*/
+
+/*  Timer4 counts 10 bits at CK/16, a tick is 1 usec, and the overflows every
+ *  1024 usec extend it to 26 bits.  */
+#define PROFILE_TICKS_MASK   0x3FFFFFFUL
+#define PROFILE_BUDGET_TICKS (1000000UL / FPS)
+
+static volatile uint16_t profileOverflowCount;
+static uint8_t profilePhase = PHASE_COUNT;
+static uint32_t profilePhaseStart;
+static uint32_t profileFrameCount;
+
+ISR(TIMER4_OVF_vect) {
+  profileOverflowCount++;
+}
+
+static void initProfile(void) {
+  TCCR4A = 0;
+  TCCR4C = 0;
+  TCCR4D = 0;
+  TCCR4E = 0;
+  TC4H = 0x03;
+  OCR4C = 0xFF;
+  TC4H = 0;
+  TCNT4 = 0;
+  TCCR4B = _BV(CS42) | _BV(CS40);
+  TIFR4 = _BV(TOV4);
+  TIMSK4 = _BV(TOIE4);
+  initFrameProfile(&frameProfile);
+#ifdef CGLAB_PROFILE_SERIAL
+  Serial.begin(9600);
+#endif
+}
+
+static uint32_t getProfileTicks(void) {
+  uint8_t sreg = SREG;
+  cli();
+  uint8_t low = TCNT4;
+  uint16_t count = (TC4H << 8) | low;
+  uint16_t overflowCount = profileOverflowCount;
+  if ((TIFR4 & _BV(TOV4)) && count < 0x200) {
+    overflowCount++;
+  }
+  SREG = sreg;
+  return ((uint32_t)overflowCount << 10) | count;
+}
+
+#ifdef CGLAB_PROFILE_SERIAL
+PROGMEM static const char profileHeader[] =
+    "frames,engineMin,engineAvg,engineMax,updateMin,updateAvg,updateMax,"
+    "particlesMin,particlesAvg,particlesMax,scoreBoardsMin,scoreBoardsAvg,"
+    "scoreBoardsMax,drawScoreMin,drawScoreAvg,drawScoreMax,presentMin,"
+    "presentAvg,presentMax,busyMin,busyAvg,busyMax,bin0,bin1,bin2,bin3,"
+    "bin4,bin5,bin6,bin7,bin8";
+
+static void printProfileStat(const ProfileStat *stat) {
+  Serial.print(',');
+  Serial.print(stat->min);
+  Serial.print(',');
+  Serial.print(stat->total / PROFILE_WINDOW_FRAMES);
+  Serial.print(',');
+  Serial.print(stat->max);
+}
+
+/*  A line of the min, the average and the max usec of each phase and of the
+ *  busy time, and the histogram of the window. The header is written when
+ *  the serial monitor is opened.  */
+static void printFrameProfile(void) {
+  static bool isConnected;
+  if (!Serial.dtr()) {
+    isConnected = false;
+    return;
+  }
+  if (!isConnected) {
+    Serial.println((const __FlashStringHelper *)profileHeader);
+    isConnected = true;
+  }
+  Serial.print(profileFrameCount);
+  for (uint8_t i = 0; i < PROFILE_PHASE_COUNT; i++) {
+    printProfileStat(&frameProfile.phases[i]);
+  }
+  printProfileStat(&frameProfile.busy);
+  for (uint8_t i = 0; i < PROFILE_HISTOGRAM_COUNT; i++) {
+    Serial.print(',');
+    Serial.print(frameProfile.histogram[i]);
+  }
+  Serial.println();
+}
+#endif
+
+void md_markPhase(uint8_t phase) {
+  uint32_t now = getProfileTicks();
+  if (profilePhase < PHASE_COUNT) {
+    uint32_t ticks = (now - profilePhaseStart) & PROFILE_TICKS_MASK;
+    addProfileTicks(&frameProfile, profilePhase,
+                    (ticks > UINT16_MAX) ? UINT16_MAX : ticks);
+    // PHASE_ENGINE is also marked after the game's phases in the frame.
+    if (phase == PHASE_ENGINE && profilePhase == PHASE_IDLE) {
+      profileFrameCount++;
+      if (endProfileFrame(&frameProfile, PROFILE_BUDGET_TICKS)) {
+#ifdef CGLAB_PROFILE_SERIAL
+        printFrameProfile();
+#endif
+        startProfileWindow(&frameProfile);
+        now = getProfileTicks();
+      }
+    }
+  }
+  profilePhase = phase;
+  profilePhaseStart = now;
+}
+#endif
+
+#ifdef CGLAB_TRACE
+
+/*---------------------------------------------------------------------------*/
+
+/*  The time is the low byte of the overflow count of Timer0, which runs at
+ *  CK/64 for millis(), and the count of it, in 4 usec.  */
+extern volatile unsigned long timer0_overflow_count;
+
+uint16_t md_getTraceTime(void) {
+  uint8_t sreg = SREG;
+  cli();
+  uint8_t count = TCNT0;
+  uint8_t overflowCount = timer0_overflow_count;
+  if ((TIFR0 & _BV(TOV0)) && count < 0xFF) {
+    overflowCount++;
+  }
+  SREG = sreg;
+  return (overflowCount << 8) | count;
+}
+
+PROGMEM static const char traceHeader[] = "time,event,value";
+
+void md_dumpTrace(const TraceEvent *events, uint8_t first, uint16_t count) {
+  if (!Serial.dtr()) {
+    return;
+  }
+  Serial.println((const __FlashStringHelper *)traceHeader);
+  for (uint16_t i = 0; i < count; i++) {
+    const TraceEvent *event = &events[(first + i) & (CGLAB_TRACE_SIZE - 1)];
+    Serial.print(event->time);
+    Serial.print(',');
+    Serial.print((uint16_t)event->type);
+    Serial.print(',');
+    Serial.println((uint16_t)event->value);
+  }
+}
+#endif
+
+#ifdef CGLAB_MEMORY_PROBE
+
+/*---------------------------------------------------------------------------*/
+
+/*  The deepest stack is the lowest byte which isn't the paint. The search
+ *  goes down from the stack pointer and ends at a run of STACK_PAINT_RUN
+ *  paint bytes, so that a byte of a stack frame which happens to be the
+ *  paint or a small local array not written to doesn't end it early, and it
+ *  takes the time of the used part only. The bytes right below the stack
+ *  pointer are left for the frames of the probe itself.  */
+#define STACK_PAINT        0xA5
+#define STACK_PAINT_RUN    32
+#define STACK_PAINT_MARGIN 16
+
+extern uint8_t __heap_start;
+extern void *__brkval;
+
+static uint8_t *getHeapEnd(void) {
+  return __brkval ? (uint8_t *)__brkval : &__heap_start;
+}
+
+static uint8_t *getPaintEnd(void) {
+  return (uint8_t *)SP - STACK_PAINT_MARGIN;
+}
+
+static void paintStack(uint8_t *from, uint8_t *to) {
+  for (uint8_t *p = from; p < to; p++) {
+    *p = STACK_PAINT;
+  }
+}
+
+static void paintFreeStack(void) {
+  paintStack(getHeapEnd(), getPaintEnd());
+}
+
+uint16_t md_measureStack(uint16_t *freeSize) {
+  uint8_t *heapEnd = getHeapEnd();
+  uint8_t *paintEnd = getPaintEnd();
+  uint8_t *lowest = paintEnd;
+  uint8_t runLength = 0;
+  for (uint8_t *p = paintEnd - 1; p >= heapEnd && runLength < STACK_PAINT_RUN;
+       p--) {
+    if (*p == STACK_PAINT) {
+      runLength++;
+    } else {
+      runLength = 0;
+      lowest = p;
+    }
+  }
+  paintStack(lowest, paintEnd);
+  *freeSize = lowest - heapEnd;
+  return (uint8_t *)RAMEND + 1 - lowest;
 }
+#endif
 
 /*---------------------------------------------------------------------------*/
 
@@ -144,6 +370,7 @@ void md_stopSound(bool isBgm) {
 
 #define stopTimer(t) do { \
             bitClear(TIMSK ## t, OCIE ## t ## A); \
+            TCCR ## t ## B &= 0b11111000; \
             setLowTimerPin(t); \
         } while (false)
 
@@ -153,37 +380,30 @@ static void initAudio(void) {
   initTimer(3);
   initTimer(1);
   stopAllSounds();
+  OCR0B = 0x80;
+  bitSet(TIMSK0, OCIE0B);
 }
 
 static void closeAudio(void) {
+  bitClear(TIMSK0, OCIE0B);
   stopAllSounds();
   power_timer3_disable();
   power_timer1_disable();
 }
 
-static volatile const uint8_t *soundData[MAX_CHANNEL];
-static volatile uint32_t pinToggleCount[MAX_CHANNEL];
-static volatile uint8_t playingFlag;
+static SoundSequence soundSequences[MAX_CHANNEL];
 
 static void playSound(uint8_t chan, const uint8_t *sound) {
   if (chan >= MAX_CHANNEL) return;
   stopSound(chan);
-  soundData[chan] = sound;
+  startSoundSequence(&soundSequences[chan], sound, millis());
   forwardSound(chan);
 }
 
 static void stopSound(uint8_t chan) {
   if (chan >= MAX_CHANNEL) return;
-  switch (chan) {
-  case 0:
-    stopTimer(3);
-    break;
-  case 1:
-    stopTimer(1);
-    break;
-  }
-  bitClear(playingFlag, chan);
-  soundData[chan] = NULL;
+  stopNote(chan);
+  soundSequences[chan].data = NULL;
 }
 
 static void stopAllSounds(void) {
@@ -192,75 +412,77 @@ static void stopAllSounds(void) {
   }
 }
 
-#define COMMAND_PLAY_NOTE 0x90 // play a note, note is next byte
-#define COMMAND_STOP_NOTE 0x80 // stop a note
-#define COMMAND_STOP      0xF0 // stop playing
-#define COMMAND_RESTART   0xE0 // stop playing (not restart)
+static bool isSoundPlaying(uint8_t chan) {
+  return chan < MAX_CHANNEL && soundSequences[chan].data != NULL;
+}
 
-#define FREQUENCY_IDLE    1000
 #define NOTE_MAX          127
-#define NOTE_MIDDLE       sizeof(midiNoteFreqByte)
 
-PROGMEM static const uint8_t midiNoteFreqByte[] = {
-  16, 17, 18, 19, 21, 22, 23, 24, 26, 28, 29, 31, 33, 35, 37, 39, 41, 44, 46,
-  49, 52, 55, 58, 62, 65, 69, 73, 78, 82, 87, 92, 98, 104, 110, 117, 123,
-  131, 139, 147, 156, 165, 175, 185, 196, 208, 220, 233, 247
-};
-PROGMEM static const uint16_t midiNoteFreqWord[] = {
-  262, 277, 294, 311, 330, 349, 370, 392, 415, 440, 466, 494, 523, 554, 587,
-  622, 659, 698, 740, 784, 831, 880, 932, 988, 1047, 1109, 1175, 1245, 1319,
-  1397, 1480, 1568, 1661, 1760, 1865, 1976, 2093, 2217, 2349, 2489, 2637, 2794,
-  2960, 3136, 3322, 3520, 3729, 3951, 4186, 4435, 4699, 4978, 5274, 5588, 5920,
-  6272, 6645, 7040, 7459, 7902, 8372, 8870, 9397, 9956, 10548, 11175, 11840,
-  12544, 13290, 14080, 14917, 15804, 16744, 17740, 18795, 19912, 21096, 22351,
-  23680, 25088
-};
+/*  Notes are sequenced with the millisecond clock, so that the tone timer
+ *  interrupts only toggle the speaker pins. The main loop polls it while
+ *  waiting for the next frame, and the compare B interrupt of Timer0, which
+ *  runs millis() and fires every 1.024 ms, polls it while the frame is being
+ *  updated and drawn. A note change is late by at most about 1 ms, or while
+ *  the main loop is starting or stopping a sound (isSoundBusy), until the
+ *  next interrupt. The interrupt enables the interrupts again at once, so
+ *  that the tones and millis() aren't held up by it. The next deadline still
+ *  counts from the due time, so the tempo doesn't drift.  */
+static void updateSounds(void) {
+  isSoundBusy = true;
+  forwardDueSounds();
+  isSoundBusy = false;
+}
 
-static void forwardSound(uint8_t chan) {
-  const volatile uint8_t **pData = &soundData[chan];
-  volatile uint32_t *pCount = &pinToggleCount[chan];
-  while (*pData) {
-    uint8_t command = pgm_read_byte((*pData)++);
-    uint16_t frequency;
-    if (command == COMMAND_PLAY_NOTE) {
-      frequency = playNote(chan, pgm_read_byte((*pData)++));
-    } else if (command == COMMAND_STOP_NOTE) {
-      frequency = stopNote(chan);
-    } else if (command < 0x80) { // wait count in msec.
-      uint16_t duration = (uint16_t)command << 8 | pgm_read_byte((*pData)++);
-      *pCount = ((uint32_t)duration * frequency + 500) / 1000;
-      if (*pCount == 0) *pCount = 1;
-      break;
-    } else if (command == COMMAND_STOP || command == COMMAND_RESTART) {
-      stopSound(chan);
-      break;
+ISR(TIMER0_COMPB_vect, ISR_NOBLOCK) {
+  if (isSoundBusy) {
+    return;
+  }
+  isSoundBusy = true;
+  forwardDueSounds();
+  isSoundBusy = false;
+}
+
+static void forwardDueSounds(void) {
+  uint16_t now = millis();
+  for (uint8_t chan = 0; chan < MAX_CHANNEL; chan++) {
+    SoundSequence *sequence = &soundSequences[chan];
+    while (sequence->data && (int16_t)(now - sequence->eventTime) >= 0) {
+      forwardSound(chan);
     }
   }
 }
 
-static uint16_t playNote(uint8_t chan, uint8_t note) {
-  if (note > NOTE_MAX) return stopNote(chan);
-  uint16_t frequency = (note < NOTE_MIDDLE) ?
-                       pgm_read_byte(&midiNoteFreqByte[note]) :
-                       pgm_read_word(&midiNoteFreqWord[note - NOTE_MIDDLE]);
-  bitSet(playingFlag, chan);
-  setupSoundTimer(chan, frequency);
-  return frequency;
+static void forwardSound(uint8_t chan) {
+  SoundSequence *sequence = &soundSequences[chan];
+  if (forwardSoundSequence(sequence) == SOUND_SEQUENCE_NOTE) {
+    playNote(chan, sequence->note);
+  } else {
+    stopNote(chan);
+  }
 }
 
-static uint16_t stopNote(uint8_t chan) {
-  bitClear(playingFlag, chan);
-  setupSoundTimer(chan, FREQUENCY_IDLE);
-  return FREQUENCY_IDLE;
+static void playNote(uint8_t chan, uint8_t note) {
+  if (note > NOTE_MAX) {
+    stopNote(chan);
+    return;
+  }
+  setupSoundTimer(chan, note);
 }
 
-static void setupSoundTimer(uint8_t chan, uint16_t frequency) {
-  uint32_t ocr = F_CPU / frequency - 1;
-  uint8_t prescalerBits = 0b001;
-  if (ocr > 0xFFFF) {
-    ocr = F_CPU / 64 / frequency - 1;
-    prescalerBits = 0b011;
+static void stopNote(uint8_t chan) {
+  switch (chan) {
+  case 0:
+    stopTimer(3);
+    break;
+  case 1:
+    stopTimer(1);
+    break;
   }
+}
+
+static void setupSoundTimer(uint8_t chan, uint8_t note) {
+  uint16_t ocr = pgm_read_word(&midiNoteTimerOcr[note]);
+  uint8_t prescalerBits = (note < NOTE_PRESCALER64_COUNT) ? 0b011 : 0b001;
   switch (chan) {
   case 0:
     startTimer(3, ocr, prescalerBits);
@@ -272,11 +494,9 @@ static void setupSoundTimer(uint8_t chan, uint16_t frequency) {
 }
 
 ISR(TIMER3_COMPA_vect) {
-  if (bitRead(playingFlag, 0)) toggleTimerPin(3);
-  if (pinToggleCount[0] > 0 && --pinToggleCount[0] == 0) forwardSound(0);
+  toggleTimerPin(3);
 }
 
 ISR(TIMER1_COMPA_vect) {
-  if (bitRead(playingFlag, 1)) toggleTimerPin(1);
-  if (pinToggleCount[1] > 0 && --pinToggleCount[1] == 0) forwardSound(1);
+  toggleTimerPin(1);
 }
@@ -24,13 +24,15 @@
 
 EXTERNC void md_initMachine(void);
 EXTERNC bool md_nextFrame(void);
+EXTERNC bool md_isFrameOverrun(void);
 EXTERNC void md_refresh(void);
 
 EXTERNC void md_clearView(void);
-EXTERNC void md_drawPixel(float x, float y, int8_t color);
-EXTERNC void md_drawRect(float x, float y, float w, float h, int8_t color);
+EXTERNC void md_drawPixel(int16_t x, int16_t y, int8_t color);
+EXTERNC void md_drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                         int8_t color);
 EXTERNC void md_drawCharacter(const uint8_t grid[CHARACTER_WIDTH],
-                              float x, float y, int8_t color);
+                              int16_t x, int16_t y, int8_t color);
 EXTERNC uint8_t md_getInputState(void);
 
 EXTERNC bool md_getSoundEnabled(void);
@@ -38,5 +40,112 @@ EXTERNC void md_setSoundEnabled(bool isEnabled);
 EXTERNC void md_saveSoundEnabled(void);
 EXTERNC void md_playSound(const uint8_t *sound, bool isBgm);
 EXTERNC void md_stopSound(bool isBgm);
+EXTERNC bool md_isSoundPlaying(bool isBgm);
+
+// "cglabConfig.h" (see number.h) can also select the options below.
+#if defined(__has_include)
+#if __has_include("cglabConfig.h")
+#include "cglabConfig.h"
+#endif
+#endif
+
+/*  CGLAB_SIMAVR builds a sketch for the cycle benchmark under simavr, which
+ *  reads the input from GPIOR2 and writes the phase marks to GPIOR1.  */
+/*  CGLAB_PROFILE_OVERLAY draws the profile of the frames in the bottom right
+ *  corner, and CGLAB_PROFILE_SERIAL writes it in CSV to Serial.  */
+#if defined(CGLAB_SIMAVR) || defined(CGLAB_PROFILE_OVERLAY) || \
+    defined(CGLAB_PROFILE_SERIAL)
+#ifndef CGLAB_PROFILE
+#define CGLAB_PROFILE
+#endif
+#endif
+
+/*  With CGLAB_PROFILE, the library marks the start of each phase of a frame
+ *  and the time until the next mark is counted for the phase. PHASE_ENGINE is
+ *  marked again in the frame after the game's phases, so a frame starts at
+ *  the PHASE_ENGINE mark that follows PHASE_IDLE.  */
+enum PHASE_ENUM {
+  PHASE_ENGINE = 0,
+  PHASE_UPDATE,
+  PHASE_PARTICLES,
+  PHASE_SCORE_BOARDS,
+  PHASE_DRAW_SCORE,
+  PHASE_PRESENT,
+  PHASE_IDLE,
+  PHASE_COUNT,
+};
+
+#ifdef CGLAB_PROFILE
+EXTERNC void md_markPhase(uint8_t phase);
+#define MARK_PHASE(phase) md_markPhase(phase)
+#else
+#define MARK_PHASE(phase)
+#endif
+
+/*  With CGLAB_COLLISION_HOOK, the library passes the result of each drawing
+ *  function to md_hookCollision() before returning it. Only the functions
+ *  that the games call pass it, not the texts that the engine draws itself,
+ *  whose collisions no game sees.  */
+#ifdef CGLAB_COLLISION_HOOK
+EXTERNC void md_hookCollision(const uint16_t *isColliding);
+#define HOOK_COLLISION(cl) md_hookCollision((cl)->isColliding)
+#else
+#define HOOK_COLLISION(cl)
+#endif
+
+/*  With CGLAB_COST_HOOK, the library passes the number of the hit boxes which
+ *  each new one is tested against to md_hookHitBoxTests().  */
+#ifdef CGLAB_COST_HOOK
+EXTERNC void md_hookHitBoxTests(uint8_t count);
+#define HOOK_HIT_BOX_TESTS(count) md_hookHitBoxTests(count)
+#else
+#define HOOK_HIT_BOX_TESTS(count)
+#endif
+
+/*  With CGLAB_TRACE, the library records the events of the frames into a
+ *  ring with the time of md_getTraceTime() in 4 usec units, which wraps
+ *  around in 262 msec, and dumpTrace() passes the events in the ring to
+ *  md_dumpTrace(), the oldest one at `first`, to write them as CSV lines.
+ *  The values are the low 12 bits, and the draw calls of a frame are the
+ *  counts of CGLAB_STATS, which CGLAB_TRACE turns on.  */
+enum TRACE_ENUM {
+  TRACE_FRAME_BEGIN = 0,  // ticks
+  TRACE_FRAME_END,        // draw calls in the frame
+  TRACE_STATE,            // the new state
+  TRACE_PLAY,             // the sound effect type
+  TRACE_ADD_SCORE,        // the value
+  TRACE_GAME_OVER,        // the score
+  TRACE_HIT_BOX_OVERFLOW, // 0, at the first dropped hit box of a frame
+  TRACE_TYPE_COUNT,
+};
+
+typedef struct {
+  uint16_t time;
+  uint16_t type:4;
+  uint16_t value:12;
+} TraceEvent;
+
+#ifdef CGLAB_TRACE
+#ifndef CGLAB_STATS
+#define CGLAB_STATS
+#endif
+#ifndef CGLAB_TRACE_SIZE
+#define CGLAB_TRACE_SIZE 64
+#endif
+#if CGLAB_TRACE_SIZE > 256 || (CGLAB_TRACE_SIZE & (CGLAB_TRACE_SIZE - 1))
+#error "CGLAB_TRACE_SIZE must be a power of 2 up to 256"
+#endif
+EXTERNC uint16_t md_getTraceTime(void);
+EXTERNC void md_dumpTrace(const TraceEvent *events, uint8_t first,
+                          uint16_t count);
+#endif
+
+/*  With CGLAB_MEMORY_PROBE, md_initMachine() paints the free RAM between the
+ *  heap and the stack, and md_measureStack() returns the bytes of the stack
+ *  used at the deepest since the last call, sets the free bytes left below
+ *  it, and paints the used part again.  */
+#ifdef CGLAB_MEMORY_PROBE
+EXTERNC uint16_t md_measureStack(uint16_t *freeSize);
+#endif
 
 #endif
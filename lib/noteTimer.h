@@ -0,0 +1,36 @@
+/// \cond
+#ifndef NOTE_TIMER_H
+#define NOTE_TIMER_H
+
+#include <stdint.h>
+
+#if F_CPU != 16000000L
+#error "midiNoteTimerOcr assumes F_CPU = 16MHz, regenerate it with sound_gen.py"
+#endif
+
+/*  Output compare values for toggling the speaker pin at twice the note
+ *  frequency. The lowest NOTE_PRESCALER64_COUNT notes need the CK/64
+ *  prescaler to fit in 16 bits.  */
+// This code is generated by 'sound_gen.py --timer-table' (F_CPU = 16000000)
+#define NOTE_PRESCALER64_COUNT 47
+PROGMEM static const uint16_t midiNoteTimerOcr[] = {
+  15624, 14704, 13887, 13156, 11903, 11362, 10868, 10415,
+  9614, 8927, 8619, 8063, 7574, 7141, 6755, 6409,
+  6096, 5680, 5433, 5101, 4806, 4544, 4309, 4031,
+  3845, 3622, 3423, 3204, 3047, 2872, 2716, 2550,
+  2402, 2271, 2135, 2031, 1907, 1797, 1699, 1601,
+  1514, 1427, 1350, 1274, 1200, 1135, 1071, 64776,
+  61067, 57760, 54420, 51445, 48483, 45844, 43242, 40815,
+  38553, 36362, 34333, 32387, 30591, 28879, 27256, 25722,
+  24278, 22921, 21620, 20407, 19252, 18180, 17166, 16193,
+  15280, 14426, 13616, 12850, 12129, 11452, 10809, 10203,
+  9631, 9089, 8578, 8096, 7643, 7215, 6810, 6427,
+  6066, 5725, 5404, 5101, 4815, 4544, 4289, 4048,
+  3821, 3606, 3403, 3213, 3032, 2862, 2701, 2550,
+  2406, 2271, 2144, 2023, 1910, 1802, 1701, 1606,
+  1515, 1430, 1350, 1274, 1202, 1135, 1071, 1011,
+  954, 900, 850, 802, 757, 714, 674, 636,
+};
+/// \endcond
+
+#endif
@@ -0,0 +1,90 @@
+#include "number.h"
+
+#ifdef CGLAB_FIXED_POINT
+#include <Arduino.h>
+
+// sin(i * PI / 128) * 256 for the first quadrant.
+PROGMEM static const uint16_t quarterSinTable[] = {
+  0, 6, 13, 19, 25, 31, 38, 44, 50, 56, 62, 68, 74,
+  80, 86, 92, 98, 104, 109, 115, 121, 126, 132, 137, 142, 147,
+  152, 157, 162, 167, 172, 177, 181, 185, 190, 194, 198, 202, 206,
+  209, 213, 216, 220, 223, 226, 229, 231, 234, 237, 239, 241, 243,
+  245, 247, 248, 250, 251, 252, 253, 254, 255, 255, 256, 256, 256,
+};
+
+#define ANGLE_TO_INDEX 10430 // 65536 / (PI * 2)
+
+Number numAbs(Number v) {
+  return v < 0 ? -v : v;
+}
+
+static uint32_t isqrt(uint32_t n) {
+  uint32_t root = 0;
+  uint32_t b = 1UL << 30;
+  while (b > n) {
+    b >>= 2;
+  }
+  while (b) {
+    if (n >= root + b) {
+      n -= root + b;
+      root = (root >> 1) + b;
+    } else {
+      root >>= 1;
+    }
+    b >>= 2;
+  }
+  return root;
+}
+
+Number numSqrt(Number v) {
+  if (v <= 0) {
+    return 0;
+  }
+  if (v < (1L << (32 - NUMBER_SHIFT - 1))) {
+    return isqrt((uint32_t)v << NUMBER_SHIFT);
+  }
+  return isqrt(v) << (NUMBER_SHIFT / 2);
+}
+
+//! Sine of `index * PI / 128`.
+Number numSinIndex(uint8_t index) {
+  uint8_t i = index & 0x3F;
+  if (index & 0x40) {
+    i = 0x40 - i;
+  }
+  Number v = pgm_read_word(&quarterSinTable[i]);
+  return (index & 0x80) ? -v : v;
+}
+
+// The index is the low 8 bits of the angle in 1/256 turns, so the product
+// wraps around in unsigned arithmetic for any angle instead of overflowing.
+static uint8_t getAngleIndex(Number angle) {
+  return ((uint32_t)angle * ANGLE_TO_INDEX + 0x8000) >> 16;
+}
+
+Number numSin(Number angle) {
+  return numSinIndex(getAngleIndex(angle));
+}
+
+Number numCos(Number angle) {
+  return numSinIndex(getAngleIndex(angle) + 0x40);
+}
+
+Number numAtan2(Number y, Number x) {
+  Number ax = numAbs(x);
+  Number ay = numAbs(y);
+  if (ax == 0 && ay == 0) {
+    return 0;
+  }
+  // atan(z) ~= z * (PI / 4 + 0.273 * (1 - z)) for z in [0, 1].
+  Number z = (ay > ax) ? NUM_DIV(ax, ay) : NUM_DIV(ay, ax);
+  Number a = NUM_MUL(z, NUM(M_PI / 4) + NUM_MUL(NUM(0.273f), NUMBER_ONE - z));
+  if (ay > ax) {
+    a = NUM(M_PI / 2) - a;
+  }
+  if (x < 0) {
+    a = NUM(M_PI) - a;
+  }
+  return (y < 0) ? -a : a;
+}
+#endif
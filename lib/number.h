@@ -0,0 +1,64 @@
+/// \cond
+#ifndef NUMBER_H
+#define NUMBER_H
+
+#ifdef __cplusplus
+#define EXTERNC extern "C"
+#else
+#define EXTERNC extern
+#endif
+
+#include <math.h>
+#include <stdint.h>
+
+// A sketch can put its own "cglabConfig.h" next to the library files to
+// select build options such as `CGLAB_FIXED_POINT`.
+#if defined(__has_include)
+#if __has_include("cglabConfig.h")
+#include "cglabConfig.h"
+#endif
+#endif
+
+#ifdef CGLAB_FIXED_POINT
+typedef int32_t Number;
+
+#define NUMBER_SHIFT 8
+#define NUMBER_ONE   ((Number)1 << NUMBER_SHIFT)
+
+#define NUM_INT(v)    ((int16_t)((v) >> NUMBER_SHIFT))
+#define NUM_CEIL(v)   (((v) + NUMBER_ONE - 1) >> NUMBER_SHIFT)
+#define NUM_MUL(a, b) (((Number)(a) * (b)) >> NUMBER_SHIFT)
+#define NUM_DIV(a, b) (((Number)(a) << NUMBER_SHIFT) / (b))
+
+EXTERNC Number numAbs(Number v);
+EXTERNC Number numSqrt(Number v);
+EXTERNC Number numSinIndex(uint8_t index);
+EXTERNC Number numSin(Number angle);
+EXTERNC Number numCos(Number angle);
+EXTERNC Number numAtan2(Number y, Number x);
+#else
+typedef float Number;
+
+#define NUM_INT(v)    (v)
+#define NUM_CEIL(v)   ceilf(v)
+#define NUM_MUL(a, b) ((a) * (b))
+#define NUM_DIV(a, b) ((a) / (b))
+
+#define numAbs   fabsf
+#define numSqrt  sqrtf
+#define numSin   sinf
+#define numCos   cosf
+#define numAtan2 atan2f
+#endif
+/// \endcond
+
+#ifdef CGLAB_FIXED_POINT
+//! Convert a constant or an integer to `Number`. In `CGLAB_FIXED_POINT` mode,
+//! `Number` is a 24.8 fixed-point value and constants are folded at compile
+//! time, otherwise it is `float`.
+#define NUM(v) ((Number)((v) * NUMBER_ONE))
+#else
+#define NUM(v) ((float)(v))
+#endif
+
+#endif
@@ -2,70 +2,79 @@
 
 #include "cglab.h"
 #include "machineDependent.h"
+#include "particle.h"
 #include "vector.h"
 
-typedef struct {
-  uint8_t x;
-  uint8_t y:7;
-  uint8_t color:1;
-  float length;
-  uint16_t ticks:6;
-  uint16_t speed:4;
-  uint16_t angle:6;
-} Particle;
-
-#define MAX_PARTICLE_COUNT 16
-static Particle particles[MAX_PARTICLE_COUNT];
-static uint8_t particleIndex = 0;
-
-void initParticle() {
+void initParticle(ParticlePool *pool) {
   for (uint8_t i = 0; i < MAX_PARTICLE_COUNT; i++) {
-    particles[i].ticks = 0;
+    pool->particles[i].ticks = 0;
   }
+  pool->index = 0;
 }
 
-void addParticle(float x, float y, float count, float speed, float angle,
-                 float angleWidth) {
-  if (color == TRANSPARENT ||
-      x < 0 || y < 0 || x >= VIEW_SIZE_X || y >= VIEW_SIZE_Y) {
+void addParticle(ParticlePool *pool, Number x, Number y, Number count,
+                 Number speed, Number angle, Number angleWidth) {
+  if (color == TRANSPARENT || x < 0 || y < 0 ||
+      x >= NUM(VIEW_SIZE_X) || y >= NUM(VIEW_SIZE_Y)) {
     return;
   }
-  if (count < 1) {
-    if (rnd(0, 1) > count) {
+  if (count < NUM(1)) {
+    if (rnd(0, NUM(1)) > count) {
       return;
     }
-    count = 1;
+    count = NUM(1);
   }
-  for (uint8_t i = 0; i < count; i++) {
-    Particle *p = &particles[particleIndex];
-    p->x = x;
-    p->y = y;
+  for (uint8_t i = 0; NUM(i) < count; i++) {
+    Particle *p = &pool->particles[pool->index];
+    if (p->ticks > 0) {
+      ADD_STAT(evictedParticleCount, 1);
+    }
+    p->x = NUM_INT(x);
+    p->y = NUM_INT(y);
     p->color = (color >= LIGHT1);
     p->length = 0;
-    p->ticks = clamp(rnd(10, 20) + sqrtf(fabsf(speed)), 10, 60);
-    float s = (sqrtf(speed * rnd(0.5f, 1) * 2048.0f) - p->ticks) / 16.0f;
-    p->speed = clamp(s, 0, 15);
-    float a = angle + rnd(0, angleWidth) - angleWidth / 2;
+    p->ticks = NUM_INT(clamp(rnd(NUM(10), NUM(20)) + numSqrt(numAbs(speed)),
+                             NUM(10), NUM(60)));
+    Number s = (numSqrt(NUM_MUL(speed, rnd(NUM(0.5f), NUM(1))) * 2048) -
+                NUM(p->ticks)) / 16;
+    p->speed = NUM_INT(clamp(s, 0, NUM(15)));
+    Number a = angle + rnd(0, angleWidth) - angleWidth / 2;
+#ifdef CGLAB_FIXED_POINT
+    p->angle = ((a * 2608 + 0x8000) >> 16) & 0x3F; // a * 32 / PI
+#else
     p->angle = (uint16_t)(a * 32.0f / M_PI + 0.5f) & 0x3F;
-    particleIndex++;
-    if (particleIndex >= MAX_PARTICLE_COUNT) {
-      particleIndex = 0;
+#endif
+    pool->index++;
+    if (pool->index >= MAX_PARTICLE_COUNT) {
+      pool->index = 0;
     }
   }
 }
 
-void updateParticles() {
+// Move the particles, and draw them with `isDrawing`.
+void updateParticles(ParticlePool *pool, bool isDrawing) {
   for (uint8_t i = 0; i < MAX_PARTICLE_COUNT; i++) {
-    Particle *p = &particles[i];
+    Particle *p = &pool->particles[i];
     if (p->ticks == 0) {
       continue;
     }
-    float v = p->speed * 16.0f + p->ticks;
-    p->length += (v * v) / 2048.0f;
+    uint16_t v = p->speed * 16 + p->ticks;
+    p->length += NUM((uint32_t)v * v) / 2048;
     p->ticks--;
+    if (!isDrawing) {
+      continue;
+    }
+#ifdef CGLAB_FIXED_POINT
+    uint8_t ai = p->angle << 2;
+    md_drawPixel(p->x + NUM_INT(NUM_MUL(numSinIndex(ai + 0x40), p->length)),
+                 p->y + NUM_INT(NUM_MUL(numSinIndex(ai), p->length)),
+                 p->color ? INVERT1 : DARK1);
+#else
     Vector pos;
     vectorSet(&pos, p->x, p->y);
     addWithAngle(&pos, p->angle * M_PI / 32.0, p->length);
     md_drawPixel(VEC_XY(pos), p->color ? INVERT1 : DARK1);
+#endif
+    ADD_STAT(pixelDrawCount, 1);
   }
 }
@@ -7,9 +7,38 @@
 #define EXTERNC extern
 #endif
 
-EXTERNC void initParticle();
-EXTERNC void addParticle(float x, float y, float count, float speed,
-                         float angle, float angleWidth);
-EXTERNC void updateParticles();
+#include <stdbool.h>
+
+#include "number.h"
+
+// `length` is the first so that the host has no padding either.
+typedef struct {
+  Number length;
+  uint8_t x;
+  uint8_t y:7;
+  uint8_t color:1;
+  uint16_t ticks:6;
+  uint16_t speed:4;
+  uint16_t angle:6;
+} Particle;
+
+#ifndef MAX_PARTICLE_COUNT
+#define MAX_PARTICLE_COUNT 16
+#endif
+#if MAX_PARTICLE_COUNT < 1 || MAX_PARTICLE_COUNT > 255
+#error "MAX_PARTICLE_COUNT must be from 1 to 255"
+#endif
+
+// The particles of a game, in the engine state of it. A new one overwrites
+// the oldest.
+typedef struct {
+  Particle particles[MAX_PARTICLE_COUNT];
+  uint8_t index;
+} ParticlePool;
+
+EXTERNC void initParticle(ParticlePool *pool);
+EXTERNC void addParticle(ParticlePool *pool, Number x, Number y, Number count,
+                         Number speed, Number angle, Number angleWidth);
+EXTERNC void updateParticles(ParticlePool *pool, bool isDrawing);
 
 #endif
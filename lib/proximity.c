@@ -0,0 +1,39 @@
+#include "proximity.h"
+
+#define POS_AT(index) \
+  ((const Vector *)((const uint8_t *)pos + (uint16_t)(index) * stride))
+
+//! Sort-and-sweep on x: items are sorted by `pos.x` into `order` (`count`
+//! bytes) and only the items within `distance` on x are tested against each
+//! other.
+uint8_t findPairsWithin(const Vector *pos, uint8_t count, uint8_t stride,
+                        Number distance, uint8_t *order, ProximityPair *pairs,
+                        uint8_t maxPairCount) {
+  for (uint8_t i = 0; i < count; i++) {
+    Number x = POS_AT(i)->x;
+    uint8_t j = i;
+    for (; j > 0 && POS_AT(order[j - 1])->x > x; j--) {
+      order[j] = order[j - 1];
+    }
+    order[j] = i;
+  }
+  uint8_t pairCount = 0;
+  for (uint8_t a = 0; a < count; a++) {
+    const Vector *p = POS_AT(order[a]);
+    for (uint8_t b = a + 1; b < count; b++) {
+      const Vector *q = POS_AT(order[b]);
+      if (q->x - p->x >= distance) {
+        break;
+      }
+      if (withinDistance((Vector *)p, q->x, q->y, distance)) {
+        if (pairCount >= maxPairCount) {
+          return pairCount;
+        }
+        ProximityPair *pp = &pairs[pairCount++];
+        pp->i = (order[a] < order[b]) ? order[a] : order[b];
+        pp->j = (order[a] < order[b]) ? order[b] : order[a];
+      }
+    }
+  }
+  return pairCount;
+}
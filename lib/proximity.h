@@ -0,0 +1,34 @@
+/// \cond
+#ifndef PROXIMITY_H
+#define PROXIMITY_H
+
+#ifdef __cplusplus
+#define EXTERNC extern "C"
+#else
+#define EXTERNC extern
+#endif
+
+#include "vector.h"
+
+typedef struct {
+  uint8_t i;
+  uint8_t j;
+} ProximityPair;
+
+EXTERNC uint8_t findPairsWithin(const Vector *pos, uint8_t count,
+                                uint8_t stride, Number distance,
+                                uint8_t *order, ProximityPair *pairs,
+                                uint8_t maxPairCount);
+/// \endcond
+
+//! Find all pairs of items in the `array` whose `pos` members are closer than
+//! `distance`, and store their indexes into the `pairs` array of
+//! `ProximityPair`. `order` is a `uint8_t` array of as many items as `array`,
+//! which the items are sorted into. Returns the number of found pairs, up to
+//! the size of `pairs`.
+#define FIND_PAIRS_WITHIN(array, distance, order, pairs)              \
+  findPairsWithin(&array[0].pos, sizeof(array) / sizeof(array[0]),  \
+                  sizeof(array[0]), distance, order, pairs,         \
+                  sizeof(pairs) / sizeof(pairs[0]))
+
+#endif
@@ -0,0 +1,21 @@
+#include "random.h"
+
+// xorshift128, the same generator as `MyRandom` in 'sound_gen.py'.
+uint32_t randomNext(Random *random) {
+  uint32_t t = random->x ^ (random->x << 11);
+  random->x = random->y;
+  random->y = random->z;
+  random->z = random->w;
+  random->w = random->w ^ (random->w >> 19) ^ (t ^ (t >> 8));
+  return random->w;
+}
+
+void randomSetSeed(Random *random, uint32_t seed) {
+  random->x = 123456789;
+  random->y = 362436069;
+  random->z = 521288629;
+  random->w = seed;
+  for (uint8_t i = 0; i < 32; i++) {
+    randomNext(random);
+  }
+}
@@ -0,0 +1,27 @@
+/// \cond
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#ifdef __cplusplus
+#define EXTERNC extern "C"
+#else
+#define EXTERNC extern
+#endif
+
+#include <stdint.h>
+
+typedef struct {
+  uint32_t x;
+  uint32_t y;
+  uint32_t z;
+  uint32_t w;
+} Random;
+
+EXTERNC uint32_t randomNext(Random *random);
+EXTERNC void randomSetSeed(Random *random, uint32_t seed);
+/// \endcond
+
+//! Initial value of `Random` which isn't seeded yet.
+#define RANDOM_INITIALIZER { 123456789, 362436069, 521288629, 88675123 }
+
+#endif
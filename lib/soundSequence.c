@@ -0,0 +1,68 @@
+#include "soundSequence.h"
+
+#include <Arduino.h>
+
+/*  Sound data is a byte stream generated by 'sound_gen.py'.
+ *    0x00        end
+ *    0x01 - 0x3F set the note length in frames
+ *    0x40        loop from the beginning
+ *    0x41 - 0x7F rest for (command - 0x40) frames
+ *    0x80        play a note for the note length, note is next byte
+ *    0x81 - 0xFF play the previous note + (command - 0xC0)  */
+#define COMMAND_END        0x00
+#define COMMAND_LOOP       0x40
+#define COMMAND_PLAY_NOTE  0x80
+#define COMMAND_NOTE_DELTA 0xC0
+
+// Start the sequence at `time` in msec.
+void startSoundSequence(SoundSequence *sequence, const uint8_t *data,
+                        uint16_t time) {
+  sequence->data = data;
+  sequence->start = data;
+  sequence->eventTime = time;
+  sequence->frameFraction = 0;
+  sequence->noteLength = 1;
+}
+
+static uint8_t readData(SoundSequence *sequence) {
+  return pgm_read_byte(sequence->data++);
+}
+
+/*  A frame is 16 2/3 msec. long, the remainder is carried over so that the
+ *  pattern doesn't drift from the frame clock.  */
+static void waitFrames(SoundSequence *sequence, uint8_t frameCount) {
+  uint8_t fraction = sequence->frameFraction + frameCount * 2;
+  sequence->eventTime += frameCount * 16 + fraction / 3;
+  sequence->frameFraction = fraction % 3;
+}
+
+// Read the commands up to the next note or rest, which lasts until the
+// advanced `eventTime`. At the end of the data, `data` becomes NULL.
+uint8_t forwardSoundSequence(SoundSequence *sequence) {
+  bool hasLooped = false;
+  while (sequence->data) {
+    uint8_t command = readData(sequence);
+    // The event time just goes on across the loop, so it is gapless.
+    // A pattern without any wait loops only once to avoid a hang.
+    if (command == COMMAND_LOOP && !hasLooped) {
+      sequence->data = sequence->start;
+      hasLooped = true;
+    } else if (command == COMMAND_END || command == COMMAND_LOOP) {
+      sequence->data = NULL;
+    } else if (command < COMMAND_LOOP) {
+      sequence->noteLength = command;
+    } else if (command < COMMAND_PLAY_NOTE) {
+      waitFrames(sequence, command - COMMAND_LOOP);
+      return SOUND_SEQUENCE_REST;
+    } else {
+      if (command == COMMAND_PLAY_NOTE) {
+        sequence->note = readData(sequence);
+      } else {
+        sequence->note += command - COMMAND_NOTE_DELTA;
+      }
+      waitFrames(sequence, sequence->noteLength);
+      return SOUND_SEQUENCE_NOTE;
+    }
+  }
+  return SOUND_SEQUENCE_END;
+}
@@ -0,0 +1,34 @@
+/// \cond
+#ifndef SOUND_SEQUENCE_H
+#define SOUND_SEQUENCE_H
+
+#ifdef __cplusplus
+#define EXTERNC extern "C"
+#else
+#define EXTERNC extern
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+  const uint8_t *data;
+  const uint8_t *start;
+  uint16_t eventTime;
+  uint8_t frameFraction;
+  uint8_t noteLength;
+  uint8_t note;
+} SoundSequence;
+
+enum SOUND_SEQUENCE_EVENT_ENUM {
+  SOUND_SEQUENCE_NOTE = 0,
+  SOUND_SEQUENCE_REST,
+  SOUND_SEQUENCE_END,
+};
+
+EXTERNC void startSoundSequence(SoundSequence *sequence, const uint8_t *data,
+                                uint16_t time);
+EXTERNC uint8_t forwardSoundSequence(SoundSequence *sequence);
+/// \endcond
+
+#endif
@@ -2,49 +2,64 @@
 
 #include <math.h>
 
-Vector* vectorSet(Vector* vec, float x, float y) {
+Vector* vectorSet(Vector* vec, Number x, Number y) {
   vec->x = x;
   vec->y = y;
   return vec;
 }
 
-Vector* vectorAdd(Vector* vec, float x, float y) {
+Vector* vectorAdd(Vector* vec, Number x, Number y) {
   vec->x += x;
   vec->y += y;
   return vec;
 }
 
-Vector* vectorMul(Vector* vec, float v) {
-  vec->x *= v;
-  vec->y *= v;
+Vector* vectorMul(Vector* vec, Number v) {
+  vec->x = NUM_MUL(vec->x, v);
+  vec->y = NUM_MUL(vec->y, v);
   return vec;
 }
 
-Vector* rotate(Vector* vec, float angle) {
-  float tx = vec->x;
-  vec->x = tx * cosf(angle) - vec->y * sinf(angle);
-  vec->y = tx * sinf(angle) + vec->y * cosf(angle);
+Vector* rotate(Vector* vec, Number angle) {
+  Number tx = vec->x;
+  vec->x = NUM_MUL(tx, numCos(angle)) - NUM_MUL(vec->y, numSin(angle));
+  vec->y = NUM_MUL(tx, numSin(angle)) + NUM_MUL(vec->y, numCos(angle));
   return vec;
 }
 
-Vector* addWithAngle(Vector* vec, float angle, float length) {
-  vec->x += cosf(angle) * length;
-  vec->y += sinf(angle) * length;
+Vector* addWithAngle(Vector* vec, Number angle, Number length) {
+  vec->x += NUM_MUL(numCos(angle), length);
+  vec->y += NUM_MUL(numSin(angle), length);
   return vec;
 }
 
-float angleTo(Vector* vec, float x, float y) {
-  return atan2f(y - vec->y, x - vec->x);
+Number angleTo(Vector* vec, Number x, Number y) {
+  return numAtan2(y - vec->y, x - vec->x);
 }
 
-float distanceTo(Vector* vec, float x, float y) {
-  float ox = x - vec->x;
-  float oy = y - vec->y;
-  return sqrtf(ox * ox + oy * oy);
+Number distanceTo(Vector* vec, Number x, Number y) {
+  Number ox = x - vec->x;
+  Number oy = y - vec->y;
+  return numSqrt(NUM_MUL(ox, ox) + NUM_MUL(oy, oy));
 }
 
-float vectorAngle(Vector* vec) { return atan2f(vec->y, vec->x); }
+Number distanceSqTo(Vector* vec, Number x, Number y) {
+  Number ox = x - vec->x;
+  Number oy = y - vec->y;
+  return NUM_MUL(ox, ox) + NUM_MUL(oy, oy);
+}
+
+bool withinDistance(Vector* vec, Number x, Number y, Number distance) {
+  Number ox = numAbs(x - vec->x);
+  Number oy = numAbs(y - vec->y);
+  if (ox >= distance || oy >= distance) {
+    return false;
+  }
+  return NUM_MUL(ox, ox) + NUM_MUL(oy, oy) < NUM_MUL(distance, distance);
+}
+
+Number vectorAngle(Vector* vec) { return numAtan2(vec->y, vec->x); }
 
-float vectorLength(Vector* vec) {
-  return sqrtf(vec->x * vec->x + vec->y * vec->y);
+Number vectorLength(Vector* vec) {
+  return numSqrt(NUM_MUL(vec->x, vec->x) + NUM_MUL(vec->y, vec->y));
 }
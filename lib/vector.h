@@ -8,20 +8,26 @@
 #define EXTERNC extern
 #endif
 
+#include <stdbool.h>
+
+#include "number.h"
+
 typedef struct {
-  float x;
-  float y;
+  Number x;
+  Number y;
 } Vector;
 
-EXTERNC Vector* vectorSet(Vector* vec, float x, float y);
-EXTERNC Vector* vectorAdd(Vector* vec, float x, float y);
-EXTERNC Vector* vectorMul(Vector* vec, float v);
-EXTERNC Vector* rotate(Vector* vec, float angle);
-EXTERNC Vector* addWithAngle(Vector* vec, float angle, float length);
-EXTERNC float angleTo(Vector* vec, float x, float y);
-EXTERNC float distanceTo(Vector* vec, float x, float y);
-EXTERNC float vectorAngle(Vector* vec);
-EXTERNC float vectorLength(Vector* vec);
+EXTERNC Vector* vectorSet(Vector* vec, Number x, Number y);
+EXTERNC Vector* vectorAdd(Vector* vec, Number x, Number y);
+EXTERNC Vector* vectorMul(Vector* vec, Number v);
+EXTERNC Vector* rotate(Vector* vec, Number angle);
+EXTERNC Vector* addWithAngle(Vector* vec, Number angle, Number length);
+EXTERNC Number angleTo(Vector* vec, Number x, Number y);
+EXTERNC Number distanceTo(Vector* vec, Number x, Number y);
+EXTERNC Number distanceSqTo(Vector* vec, Number x, Number y);
+EXTERNC bool withinDistance(Vector* vec, Number x, Number y, Number distance);
+EXTERNC Number vectorAngle(Vector* vec);
+EXTERNC Number vectorLength(Vector* vec);
 /// \endcond
 
 //! Expand 'v' to 'v.x, v.y'
@@ -0,0 +1,49 @@
+// Micro benchmarks of the primitives for `cycleRunner -b`, built with
+// CGLAB_SIMAVR. The calls run with the interrupts disabled, so that the cycles
+// are the same every time.
+#include <cglab.h>
+#include "cycleMarks.h"
+
+PROGMEM static const char title[] = "BENCH";
+PROGMEM static const char description[] = "\0";
+
+PROGMEM static const CharacterData characters[] = {
+  {{ 0x0F, 0x3F, 0x09, 0x0F, 0x19, 0x1F }, { 0, 0, 6, 6 }},
+};
+
+static char buffer[8];
+
+static void update(void) {}
+
+#define BENCH(mark, statement) do { \
+    md_markPhase(mark); \
+    for (uint8_t i = 0; i < BENCH_ITERATION_COUNT; i++) { \
+      statement; \
+    } \
+  } while (false)
+
+void setup() {
+  setupGame(title, description, characters, NULL, update);
+  initGame();
+  noInterrupts();
+  BENCH(BENCH_LOOP, asm volatile (""));
+  BENCH(BENCH_DRAW_RECT, md_drawRect(i, i / 2, 8, 8, LIGHT1));
+  BENCH(BENCH_DRAW_CHARACTER,
+        md_drawCharacter(characters[0].grid, i, i / 2, LIGHT1));
+  color = LIGHT1;
+  for (uint8_t i = 0; i < BENCH_HIT_BOX_COUNT; i++) {
+    rect(NUM(i * 2), NUM(40), NUM(2), NUM(2));
+  }
+  color = TRANSPARENT;
+  BENCH(BENCH_CHECK_HIT_BOX, rect(NUM(i), NUM(40), NUM(2), NUM(2)));
+  color = LIGHT1;
+  BENCH(BENCH_ADD_PARTICLE,
+        particle(NUM(64), NUM(32), NUM(1), NUM(1), NUM(0), NUM(M_PI * 2)));
+  BENCH(BENCH_RND, rnd(NUM(0), NUM(100)));
+  BENCH(BENCH_SPRINTF, sprintf(buffer, "%d", i * 997));
+  md_markPhase(BENCH_END);
+  interrupts();
+}
+
+void loop() {
+}
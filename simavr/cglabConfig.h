@@ -0,0 +1,9 @@
+#pragma once
+
+// Build the sketch for the cycle benchmark under simavr.
+#define CGLAB_SIMAVR
+
+// With the options of the sketch, such as the sizes of the pools.
+#if __has_include("cglabSketchConfig.h")
+#include "cglabSketchConfig.h"
+#endif
@@ -0,0 +1,21 @@
+// The marks of the micro benchmarks, which cglabBench writes to GPIOR1 in the
+// same way as the phase marks. Each mark is followed by BENCH_ITERATION_COUNT
+// calls of the primitive.
+#ifndef CYCLE_MARKS_H
+#define CYCLE_MARKS_H
+
+#define BENCH_ITERATION_COUNT 64
+#define BENCH_HIT_BOX_COUNT   64
+
+enum BENCH_ENUM {
+  BENCH_LOOP = 0x80,
+  BENCH_DRAW_RECT,
+  BENCH_DRAW_CHARACTER,
+  BENCH_CHECK_HIT_BOX,
+  BENCH_ADD_PARTICLE,
+  BENCH_RND,
+  BENCH_SPRINTF,
+  BENCH_END,
+};
+
+#endif
@@ -0,0 +1,249 @@
+// Run a sketch built with CGLAB_SIMAVR under simavr, and report the exact
+// cycles of each phase of the frames with the scripted input, and of the tone
+// timer and the sequencer interrupts, or of each micro benchmark of cglabBench
+// with -b.
+//   cycleRunner [-f frames] [-b] sketch.ino.elf
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_interrupts.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cycleMarks.h"
+#include "machineDependent.h"
+#include "scriptedInput.h"
+
+#define CPU_FREQUENCY 16000000UL
+#define FRAME_BUDGET  ((CPU_FREQUENCY + FPS / 2) / FPS)
+
+// The data addresses of the registers.
+#define GPIOR1_ADDRESS 0x4A
+#define GPIOR2_ADDRESS 0x4B
+// The interrupt vectors of the tone timers and of the sequencer of the
+// ATmega32u4.
+#define TIMER1_COMPA_VECTOR 17
+#define TIMER0_COMPB_VECTOR 22
+#define TIMER3_COMPA_VECTOR 32
+
+#define NO_MARK 0xFF
+
+// The cycles of the interrupts of a kind.
+typedef struct {
+  avr_t *avr;
+  avr_cycle_count_t startCycle;
+  avr_cycle_count_t cycles;
+  avr_cycle_count_t busyCycles;
+  uint32_t count;
+} InterruptCycles;
+#define BENCH_COUNT (BENCH_END - BENCH_LOOP)
+
+static const char *const phaseNames[PHASE_COUNT] = {
+  "engine", "update", "particles", "scoreBoards", "drawScore", "present",
+  "idle",
+};
+
+static const char *const benchNames[BENCH_COUNT] = {
+  "loop", "md_drawRect", "md_drawCharacter", "checkHitBox", "addParticle",
+  "rnd", "sprintf",
+};
+
+static elf_firmware_t firmware;
+static uint8_t currentMark = NO_MARK;
+static avr_cycle_count_t markCycle;
+static avr_cycle_count_t phaseCycles[PHASE_COUNT];
+static avr_cycle_count_t benchCycles[BENCH_COUNT];
+static uint32_t frameCount, frameCountLimit = 3000;
+static avr_cycle_count_t frameStartCycle, frameIdleCycles;
+static avr_cycle_count_t minFrameCycles = UINT64_MAX, maxFrameCycles;
+static uint32_t overBudgetFrameCount;
+static InterruptCycles toneInterrupts, sequencerInterrupts;
+static bool isFinished;
+
+static void startFrame(avr_t *avr) {
+  if (frameCount > 0) {
+    avr_cycle_count_t cycles = avr->cycle - frameStartCycle - frameIdleCycles;
+    if (cycles < minFrameCycles) {
+      minFrameCycles = cycles;
+    }
+    if (cycles > maxFrameCycles) {
+      maxFrameCycles = cycles;
+    }
+    if (cycles > FRAME_BUDGET) {
+      overBudgetFrameCount++;
+    }
+  }
+  if (frameCount == frameCountLimit) {
+    isFinished = true;
+    return;
+  }
+  avr->data[GPIOR2_ADDRESS] = getScriptedInput(frameCount);
+  frameCount++;
+  frameStartCycle = avr->cycle;
+  frameIdleCycles = 0;
+}
+
+static void onMark(avr_t *avr, avr_io_addr_t address, uint8_t mark,
+                   void *param) {
+  avr_cycle_count_t cycles = avr->cycle - markCycle;
+  if (currentMark < PHASE_COUNT) {
+    phaseCycles[currentMark] += cycles;
+    if (currentMark == PHASE_IDLE) {
+      frameIdleCycles += cycles;
+    }
+  } else if (currentMark >= BENCH_LOOP && currentMark < BENCH_END) {
+    benchCycles[currentMark - BENCH_LOOP] += cycles;
+  }
+  // PHASE_ENGINE is also marked after the game's phases in the frame.
+  bool isFrameStart = mark == PHASE_ENGINE &&
+                      (currentMark == PHASE_IDLE || currentMark == NO_MARK);
+  currentMark = mark;
+  markCycle = avr->cycle;
+  if (isFrameStart) {
+    startFrame(avr);
+  } else if (mark == BENCH_END) {
+    isFinished = true;
+  }
+}
+
+// The interrupts interrupt the phases, so their cycles are also counted in the
+// phase they interrupted. The sequencer interrupt lets the tone interrupts
+// interrupt it, so theirs are also counted in it then.
+static void onInterrupt(struct avr_irq_t *irq, uint32_t isRunning,
+                        void *param) {
+  InterruptCycles *interrupts = param;
+  if (isRunning) {
+    interrupts->startCycle = interrupts->avr->cycle;
+    return;
+  }
+  avr_cycle_count_t cycles = interrupts->avr->cycle - interrupts->startCycle;
+  interrupts->cycles += cycles;
+  if (currentMark != PHASE_IDLE) {
+    interrupts->busyCycles += cycles;
+  }
+  interrupts->count++;
+}
+
+static bool hookInterrupt(avr_t *avr, uint8_t vector,
+                          InterruptCycles *interrupts) {
+  avr_irq_t *irq = avr_get_interrupt_irq(avr, vector);
+  if (!irq) {
+    return false;
+  }
+  interrupts->avr = avr;
+  avr_irq_register_notify(irq + AVR_INT_IRQ_RUNNING, onInterrupt, interrupts);
+  return true;
+}
+
+static double getPercentage(double cycles) {
+  return 100.0 * cycles / FRAME_BUDGET;
+}
+
+static void reportInterrupts(const char *name,
+                             const InterruptCycles *interrupts) {
+  double averageCycles = (double)interrupts->cycles / frameCount;
+  printf("  %-12s %9.0f (%.1f%%), %.0f in the busy phases, "
+         "%.1f interrupts/frame\n",
+         name, averageCycles, getPercentage(averageCycles),
+         (double)interrupts->busyCycles / frameCount,
+         (double)interrupts->count / frameCount);
+}
+
+static void reportFrames(const char *name) {
+  printf("%s: %u frames, cycles/frame (the budget is %lu)\n", name,
+         frameCount, FRAME_BUDGET);
+  avr_cycle_count_t busyCycles = 0;
+  for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+    printf("  %-12s %9.0f\n", phaseNames[i],
+           (double)phaseCycles[i] / frameCount);
+    if (i != PHASE_IDLE) {
+      busyCycles += phaseCycles[i];
+    }
+  }
+  double averageCycles = (double)busyCycles / frameCount;
+  printf("  %-12s %9.0f (%.1f%%), min %llu (%.1f%%), max %llu (%.1f%%), "
+         "over the budget in %u frames\n",
+         "busy", averageCycles, getPercentage(averageCycles),
+         (unsigned long long)minFrameCycles, getPercentage(minFrameCycles),
+         (unsigned long long)maxFrameCycles, getPercentage(maxFrameCycles),
+         overBudgetFrameCount);
+  reportInterrupts("tone ISRs", &toneInterrupts);
+  reportInterrupts("sequencer", &sequencerInterrupts);
+}
+
+static void reportBenches(const char *name) {
+  printf("%s: cycles/call (%d calls, without the loop overhead)\n", name,
+         BENCH_ITERATION_COUNT);
+  double loopCycles = (double)benchCycles[0] / BENCH_ITERATION_COUNT;
+  printf("  %-17s %8.1f\n", benchNames[0], loopCycles);
+  for (uint8_t i = 1; i < BENCH_COUNT; i++) {
+    printf("  %-17s %8.1f\n", benchNames[i],
+           (double)benchCycles[i] / BENCH_ITERATION_COUNT - loopCycles);
+  }
+  printf("  (checkHitBox is rect() with %d hit boxes and no drawing)\n",
+         BENCH_HIT_BOX_COUNT);
+}
+
+int main(int argc, char *argv[]) {
+  bool isBenching = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "f:b")) != -1) {
+    if (opt == 'f') {
+      frameCountLimit = strtoul(optarg, NULL, 10);
+    } else if (opt == 'b') {
+      isBenching = true;
+    } else {
+      optind = argc;
+      break;
+    }
+  }
+  if (optind != argc - 1) {
+    fprintf(stderr, "usage: %s [-f frames] [-b] sketch.ino.elf\n", argv[0]);
+    return 1;
+  }
+  const char *path = argv[optind];
+  if (elf_read_firmware(path, &firmware) != 0) {
+    fprintf(stderr, "%s: can't read the firmware\n", path);
+    return 1;
+  }
+  avr_t *avr = avr_make_mcu_by_name("atmega32u4");
+  if (!avr) {
+    fprintf(stderr, "simavr doesn't support atmega32u4\n");
+    return 1;
+  }
+  avr_init(avr);
+  avr_load_firmware(avr, &firmware);
+  if (!avr->frequency) {
+    avr->frequency = CPU_FREQUENCY;
+  }
+  avr_register_io_write(avr, GPIOR1_ADDRESS, onMark, NULL);
+  if (!hookInterrupt(avr, TIMER1_COMPA_VECTOR, &toneInterrupts) ||
+      !hookInterrupt(avr, TIMER3_COMPA_VECTOR, &toneInterrupts) ||
+      !hookInterrupt(avr, TIMER0_COMPB_VECTOR, &sequencerInterrupts)) {
+    fprintf(stderr, "simavr doesn't have the sound interrupts\n");
+    return 1;
+  }
+
+  int state = cpu_Running;
+  while (!isFinished && state != cpu_Done && state != cpu_Crashed) {
+    state = avr_run(avr);
+  }
+  char name[64];
+  const char *baseName = strrchr(path, '/');
+  snprintf(name, sizeof(name), "%s", baseName ? baseName + 1 : path);
+  char *extension = strstr(name, ".ino.elf");
+  if (extension) {
+    *extension = '\0';
+  }
+  if (!isFinished) {
+    fprintf(stderr, "%s: the simulation stopped at frame %u\n", name,
+            frameCount);
+    return 1;
+  }
+  isBenching ? reportBenches(name) : reportFrames(name);
+  avr_terminate(avr);
+  return 0;
+}
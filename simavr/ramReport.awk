@@ -0,0 +1,47 @@
+# Sum the RAM of the data and bss symbols of `avr-nm -S -l --size-sort` by
+# the source file which defines them, and list the symbols of each file.
+#   avr-nm -S -l -C --size-sort sketch.ino.elf | awk -f ramReport.awk
+
+function hex(s,    i, v) {
+  v = 0
+  for (i = 1; i <= length(s); i++) {
+    v = v * 16 + index("0123456789abcdef", tolower(substr(s, i, 1))) - 1
+  }
+  return v
+}
+
+$3 ~ /^[bBdD]$/ {
+  tab = index($0, "\t")
+  name = substr($0, 1, tab ? tab - 1 : length($0))
+  sub(/^[^ ]+ [^ ]+ [^ ]+ /, "", name)
+  module = tab ? substr($0, tab + 1) : ""
+  sub(/:[0-9]+$/, "", module)
+  sub(/.*\//, "", module)
+  if (module == "") {
+    module = "(no line info)"
+  }
+  size = hex($2)
+  sizes[module] += size
+  # --size-sort lists the smaller first.
+  symbols[module] = sprintf("      %5d %s\n", size, name) symbols[module]
+  total += size
+}
+
+END {
+  count = 0
+  for (module in sizes) {
+    modules[++count] = module
+  }
+  for (i = 2; i <= count; i++) {
+    for (j = i; j > 1 && sizes[modules[j]] > sizes[modules[j - 1]]; j--) {
+      module = modules[j]
+      modules[j] = modules[j - 1]
+      modules[j - 1] = module
+    }
+  }
+  for (i = 1; i <= count; i++) {
+    printf "%5d %s\n%s", sizes[modules[i]], modules[i], symbols[modules[i]]
+  }
+  printf "%5d total of 2560 bytes, %d left for the heap and the stack\n",
+         total, 2560 - total
+}
@@ -218,12 +218,15 @@ def createRandomPattern(length, freq):
 		interval *= 2
 	return pattern
 
+BGM_NOTE_LENGTH = 32
+BGM_NOTE_DURATION = 8
+
 def generateBgm():
-	noteLength = 32 # bgmNoteLength
+	noteLength = BGM_NOTE_LENGTH
 	chordMidiNotes = generateChordProgression(noteLength)
 	pattern = createRandomPattern(noteLength, 1)
 	continuingPattern = [_rnd(0, 1) < 0.8 for i in range(noteLength)]
-	duration = 8
+	duration = BGM_NOTE_DURATION
 	when = -duration
 	hasPrevNote = False
 	notes = []
@@ -241,31 +244,49 @@ def generateBgm():
 
 #----- Converter
 
-BASE_NOTE_DURATION = 1000 / 60
+# Sound data format, decoded by forwardSound() in 'machineDependent.cpp':
+#   0x00         end
+#   0x01 - 0x3F  set the note length in frames
+#   0x40         loop
+#   0x41 - 0x7F  rest for (value - 0x40) frames
+#   0x80 n       play the MIDI note n for the note length
+#   0x81 - 0xFF  play the previous note + (value - 0xC0) for the note length
+MAX_FRAME_COUNT = 0x3F
 
-def convertData(notes, ch=0, rep=False):
+def convertData(notes, rep=False, length=0):
 	data = []
 	w = 0
+	noteLength = 0
+	prevNote = None
 	for note in notes:
 		if w < note['when']:
-			data.append(0x80 + ch)
-			d = note['when'] - w
-			appendWaitData(data, w, d)
-			w += d
-		data.append(0x90 + ch)
-		data.append(note['midiNote'])
+			appendRestData(data, note['when'] - w)
+			w = note['when']
 		d = note['duration']
-		appendWaitData(data, w, d)
 		w += d
-	data.append(0x80 + ch)
-	data.append(0xE0 if rep else 0xF0)
+		while d > 0: # a long note is split by replaying the same note
+			l = min(d, MAX_FRAME_COUNT)
+			if l != noteLength:
+				data.append(l)
+				noteLength = l
+			midiNote = note['midiNote']
+			if prevNote is not None and abs(midiNote - prevNote) < 0x40:
+				data.append(0xC0 + midiNote - prevNote)
+			else:
+				data.append(0x80)
+				data.append(midiNote & 0xFF)
+			prevNote = midiNote
+			d -= l
+	if w < length: # rest until the end of the bar to loop in time
+		appendRestData(data, length - w)
+	data.append(0x40 if rep else 0x00)
 	return data
 
-def appendWaitData(data, w, d):
-	ms = int((w+d)*BASE_NOTE_DURATION) - int(w*BASE_NOTE_DURATION) 
-	data.append((ms >> 8) & 0x7F)
-	data.append(ms & 0xFF)
-
+def appendRestData(data, d):
+	while d > 0:
+		l = min(d, MAX_FRAME_COUNT)
+		data.append(0x40 + l)
+		d -= l
 
 def outputData(name, data):
 	print('PROGMEM static const uint8_t ' + name + '[] = {')
@@ -289,10 +310,41 @@ def getHashFromString(title, desc, extra=0):
 		hash &= 0xFFFFFFFF
 	return hash + extra
 
+#----- Timer table
+
+F_CPU = 16000000
+
+def getTimerOcr(note):
+	frequency = round(880 * 2 ** ((note - 69) / 12)) # twice the note frequency
+	ocr = F_CPU // frequency - 1
+	if ocr > 0xFFFF:
+		return F_CPU // 64 // frequency - 1, True
+	return ocr, False
+
+def outputTimerTable():
+	table = [getTimerOcr(note) for note in range(128)]
+	print('// This code is generated by \'sound_gen.py --timer-table\' (F_CPU = ' + str(F_CPU) + ')')
+	print('#define NOTE_PRESCALER64_COUNT ' + str(sum(1 for ocr, isPrescaled in table if isPrescaled)))
+	print('PROGMEM static const uint16_t midiNoteTimerOcr[] = {')
+	for i, (ocr, isPrescaled) in enumerate(table):
+		if i % 8 == 0:
+			print('  ', end='')
+		delim = '\n' if i % 8 == 7 else ' '
+		print(str(ocr) + ',', end=delim)
+	print('};')
+
 #----- Main
 
 if __name__ == '__main__':
-	seed = r.nextRandom() if len(sys.argv) < 2 else int(sys.argv[1])
+	if len(sys.argv) >= 2 and sys.argv[1] == '--timer-table':
+		outputTimerTable()
+		sys.exit()
+	if len(sys.argv) >= 4 and sys.argv[1] == '--hash':
+		# The seed from the title and the description, whose lines are joined
+		# with '\n'.
+		seed = getHashFromString(sys.argv[2], sys.argv[3])
+	else:
+		seed = r.nextRandom() if len(sys.argv) < 2 else int(sys.argv[1])
 	r.setRandomSeed(seed)
 	print('// This code is generated by \'sound_gen.py\' (seed = ' + str(seed) + ')')
 	print()
@@ -311,8 +363,10 @@ if __name__ == '__main__':
 	print('#pragma once')
 	print()
 	for name, note in sounds.items():
-		repeat = (name == 'bgm')
-		data = convertData(note, rep=repeat)
+		if name == 'bgm':
+			data = convertData(note, rep=True, length=BGM_NOTE_LENGTH * BGM_NOTE_DURATION)
+		else:
+			data = convertData(note)
 		outputData(name, data)
 	print('PROGMEM static const uint8_t * const soundPatterns[] = {')
 	print('  ' + ',\n  '.join(sounds.keys()) + ',')